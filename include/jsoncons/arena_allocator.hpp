@@ -0,0 +1,257 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_ALLOCATOR_HPP
+#define JSONCONS_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <limits>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/json.hpp>
+
+namespace jsoncons {
+
+// monotonic_arena
+
+// Hands out memory from a list of blocks, each twice the size of the one before it, and
+// never gives memory back until reset or destroyed. Not thread safe.
+
+class monotonic_arena
+{
+    struct block
+    {
+        block* next;
+        size_t size;
+    };
+
+    static const size_t header_size = (sizeof(block) + JSONCONS_ALIGNOF(std::max_align_t) - 1)
+                                      & ~(JSONCONS_ALIGNOF(std::max_align_t) - 1);
+
+    // The largest block that can be asked of operator new along with its header
+    static const size_t max_block_size = (std::numeric_limits<size_t>::max)() - header_size;
+
+    block* head_;
+    char* ptr_;
+    char* end_;
+    size_t next_block_size_;
+    size_t bytes_allocated_;
+
+    // Noncopyable and nonmoveable
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+public:
+    static const size_t default_initial_block_size = 64*1024;
+
+    explicit monotonic_arena(size_t initial_block_size = default_initial_block_size)
+        : head_(nullptr), ptr_(nullptr), end_(nullptr),
+          next_block_size_(initial_block_size == 0 ? default_initial_block_size
+                           : initial_block_size < max_block_size ? initial_block_size : max_block_size),
+          bytes_allocated_(0)
+    {
+    }
+
+    ~monotonic_arena()
+    {
+        release_blocks(nullptr);
+    }
+
+    void* allocate(size_t n, size_t alignment)
+    {
+        char* p = align(ptr_, alignment);
+        if (p == nullptr || n > static_cast<size_t>(end_ - p))
+        {
+            if (n > max_block_size - alignment)
+            {
+                throw std::bad_alloc();
+            }
+            add_block(n + alignment);
+            p = align(ptr_, alignment);
+        }
+        ptr_ = p + n;
+        bytes_allocated_ += n;
+        return p;
+    }
+
+    // Frees all blocks but the last, which is the largest, and starts allocating from it again.
+    // Everything allocated from the arena is invalidated.
+
+    void reset()
+    {
+        if (head_ != nullptr)
+        {
+            release_blocks(head_);
+            head_->next = nullptr;
+            ptr_ = reinterpret_cast<char*>(head_) + header_size;
+            end_ = ptr_ + head_->size;
+        }
+        bytes_allocated_ = 0;
+    }
+
+    // Replaces val with null without running the destructors of its contents, which are
+    // abandoned in the arena. Only safe if everything val holds was allocated from this arena,
+    // for example a value built by a json_decoder given an arena_allocator for it.
+
+    template <class Json>
+    void release(Json& val)
+    {
+        ::new(static_cast<void*>(std::addressof(val))) Json(Json::null());
+    }
+
+    size_t bytes_allocated() const
+    {
+        return bytes_allocated_;
+    }
+
+    size_t block_count() const
+    {
+        size_t count = 0;
+        for (block* b = head_; b != nullptr; b = b->next)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    static char* align(char* p, size_t alignment)
+    {
+        if (p == nullptr)
+        {
+            return nullptr;
+        }
+        uintptr_t n = reinterpret_cast<uintptr_t>(p);
+        return p + ((alignment - (n % alignment)) % alignment);
+    }
+
+    // Sizes double up to max_block_size, and stop there rather than overflow
+    static size_t twice(size_t size)
+    {
+        return size <= max_block_size/2 ? size*2 : max_block_size;
+    }
+
+    void add_block(size_t min_size)
+    {
+        size_t size = next_block_size_;
+        while (size < min_size)
+        {
+            size = twice(size);
+        }
+        block* b = static_cast<block*>(::operator new(header_size + size));
+        b->next = head_;
+        b->size = size;
+        head_ = b;
+        ptr_ = reinterpret_cast<char*>(b) + header_size;
+        end_ = ptr_ + size;
+        next_block_size_ = twice(size);
+    }
+
+    // Frees the blocks after keep, or all of them if keep is null
+    void release_blocks(block* keep)
+    {
+        block* b = keep != nullptr ? keep->next : head_;
+        while (b != nullptr)
+        {
+            block* next = b->next;
+            ::operator delete(b);
+            b = next;
+        }
+        if (keep == nullptr)
+        {
+            head_ = nullptr;
+            ptr_ = nullptr;
+            end_ = nullptr;
+        }
+    }
+};
+
+// arena_allocator
+
+// A stateful allocator that allocates from a monotonic_arena, and whose deallocate does
+// nothing. A default constructed arena_allocator, as used by basic_json for temporaries,
+// allocates with operator new instead, and frees what it allocates.
+
+template <class T>
+class arena_allocator
+{
+    template <class U>
+    friend class arena_allocator;
+
+    monotonic_arena* arena_;
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    arena_allocator() JSONCONS_NOEXCEPT
+        : arena_(nullptr)
+    {
+    }
+
+    explicit arena_allocator(monotonic_arena& arena) JSONCONS_NOEXCEPT
+        : arena_(std::addressof(arena))
+    {
+    }
+
+    arena_allocator(const arena_allocator&) = default;
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) JSONCONS_NOEXCEPT
+        : arena_(other.arena_)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > (std::numeric_limits<size_t>::max)()/sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n*sizeof(T), JSONCONS_ALIGNOF(T)));
+    }
+
+    void deallocate(T* p, size_t) JSONCONS_NOEXCEPT
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    monotonic_arena* arena() const
+    {
+        return arena_;
+    }
+
+    template <class U>
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) JSONCONS_NOEXCEPT
+    {
+        return lhs.arena_ == rhs.arena();
+    }
+
+    template <class U>
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) JSONCONS_NOEXCEPT
+    {
+        return lhs.arena_ != rhs.arena();
+    }
+};
+
+typedef basic_json<char,sorted_policy,arena_allocator<char>> arena_json;
+typedef basic_json<wchar_t,sorted_policy,arena_allocator<wchar_t>> arena_wjson;
+typedef basic_json<char,preserve_order_policy,arena_allocator<char>> arena_ojson;
+typedef basic_json<wchar_t,preserve_order_policy,arena_allocator<wchar_t>> arena_wojson;
+
+}
+
+#endif
@@ -0,0 +1,292 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_GRISU_HPP
+#define JSONCONS_DETAIL_GRISU_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <jsoncons/jsoncons_config.hpp>
+
+// Shortest decimal representation of a double that reads back to the same double,
+// following Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately 
+// with Integers" (Grisu2), with the digit generation and rounding of Milo Yip's 
+// and Niels Lohmann's implementations.
+
+namespace jsoncons { namespace detail {
+
+struct diy_fp
+{
+    uint64_t f;
+    int e;
+
+    diy_fp(uint64_t f_, int e_)
+        : f(f_), e(e_)
+    {
+    }
+
+    static diy_fp sub(const diy_fp& x, const diy_fp& y)
+    {
+        return diy_fp(x.f - y.f, x.e);
+    }
+
+    // Returns x*y rounded to 64 bits
+    static diy_fp mul(const diy_fp& x, const diy_fp& y)
+    {
+        const uint64_t u_lo = x.f & 0xffffffff;
+        const uint64_t u_hi = x.f >> 32;
+        const uint64_t v_lo = y.f & 0xffffffff;
+        const uint64_t v_hi = y.f >> 32;
+
+        const uint64_t p0 = u_lo * v_lo;
+        const uint64_t p1 = u_lo * v_hi;
+        const uint64_t p2 = u_hi * v_lo;
+        const uint64_t p3 = u_hi * v_hi;
+
+        uint64_t q = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+        q += static_cast<uint64_t>(1) << 31;
+
+        return diy_fp(p3 + (p2 >> 32) + (p1 >> 32) + (q >> 32), x.e + y.e + 64);
+    }
+
+    static diy_fp normalize(diy_fp x)
+    {
+        while ((x.f >> 63) == 0)
+        {
+            x.f <<= 1;
+            --x.e;
+        }
+        return x;
+    }
+
+    static diy_fp normalize_to(const diy_fp& x, int e)
+    {
+        return diy_fp(x.f << (x.e - e), e);
+    }
+};
+
+struct cached_power
+{
+    uint64_t f;
+    int e;
+    int k;
+};
+
+// Returns a normalized power of ten c = 10^-k such that the binary exponent of c*w 
+// falls in [-60,-32] for a normalized w with binary exponent e
+inline
+cached_power get_cached_power(int e)
+{
+    static const cached_power cached_powers[] =
+    {
+        { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+        { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+        { 0xBE5691EF416BD60CULL, -1007, -284 },
+        { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+        { 0xD3515C2831559A83ULL,  -954, -268 },
+        { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+        { 0xEA9C227723EE8BCBULL,  -901, -252 },
+        { 0xAECC49914078536DULL,  -874, -244 },
+        { 0x823C12795DB6CE57ULL,  -847, -236 },
+        { 0xC21094364DFB5637ULL,  -821, -228 },
+        { 0x9096EA6F3848984FULL,  -794, -220 },
+        { 0xD77485CB25823AC7ULL,  -768, -212 },
+        { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+        { 0xEF340A98172AACE5ULL,  -715, -196 },
+        { 0xB23867FB2A35B28EULL,  -688, -188 },
+        { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+        { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+        { 0x936B9FCEBB25C996ULL,  -608, -164 },
+        { 0xDBAC6C247D62A584ULL,  -582, -156 },
+        { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+        { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+        { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+        { 0x87625F056C7C4A8BULL,  -475, -124 },
+        { 0xC9BCFF6034C13053ULL,  -449, -116 },
+        { 0x964E858C91BA2655ULL,  -422, -108 },
+        { 0xDFF9772470297EBDULL,  -396, -100 },
+        { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+        { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+        { 0xB94470938FA89BCFULL,  -316,  -76 },
+        { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+        { 0xCDB02555653131B6ULL,  -263,  -60 },
+        { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+        { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+        { 0xAA242499697392D3ULL,  -183,  -36 },
+        { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+        { 0xBCE5086492111AEBULL,  -130,  -20 },
+        { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+        { 0xD1B71758E219652CULL,   -77,   -4 },
+        { 0x9C40000000000000ULL,   -50,    4 },
+        { 0xE8D4A51000000000ULL,   -24,   12 },
+        { 0xAD78EBC5AC620000ULL,     3,   20 },
+        { 0x813F3978F8940984ULL,    30,   28 },
+        { 0xC097CE7BC90715B3ULL,    56,   36 },
+        { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+        { 0xD5D238A4ABE98068ULL,   109,   52 },
+        { 0x9F4F2726179A2245ULL,   136,   60 },
+        { 0xED63A231D4C4FB27ULL,   162,   68 },
+        { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+        { 0x83C7088E1AAB65DBULL,   216,   84 },
+        { 0xC45D1DF942711D9AULL,   242,   92 },
+        { 0x924D692CA61BE758ULL,   269,  100 },
+        { 0xDA01EE641A708DEAULL,   295,  108 },
+        { 0xA26DA3999AEF774AULL,   322,  116 },
+        { 0xF209787BB47D6B85ULL,   348,  124 },
+        { 0xB454E4A179DD1877ULL,   375,  132 },
+        { 0x865B86925B9BC5C2ULL,   402,  140 },
+        { 0xC83553C5C8965D3DULL,   428,  148 },
+        { 0x952AB45CFA97A0B3ULL,   455,  156 },
+        { 0xDE469FBD99A05FE3ULL,   481,  164 },
+        { 0xA59BC234DB398C25ULL,   508,  172 },
+        { 0xF6C69A72A3989F5CULL,   534,  180 },
+        { 0xB7DCBF5354E9BECEULL,   561,  188 },
+        { 0x88FCF317F22241E2ULL,   588,  196 },
+        { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+        { 0x98165AF37B2153DFULL,   641,  212 },
+        { 0xE2A0B5DC971F303AULL,   667,  220 },
+        { 0xA8D9D1535CE3B396ULL,   694,  228 },
+        { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+        { 0xBB764C4CA7A44410ULL,   747,  244 },
+        { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+        { 0xD01FEF10A657842CULL,   800,  260 },
+        { 0x9B10A4E5E9913129ULL,   827,  268 },
+        { 0xE7109BFBA19C0C9DULL,   853,  276 },
+        { 0xAC2820D9623BF429ULL,   880,  284 },
+        { 0x80444B5E7AA7CF85ULL,   907,  292 },
+        { 0xBF21E44003ACDD2DULL,   933,  300 },
+        { 0x8E679C2F5E44FF8FULL,   960,  308 },
+        { 0xD433179D9C8CB841ULL,   986,  316 },
+        { 0x9E19DB92B4E31BA9ULL,  1013,  324 }
+    };
+
+    const int f = -60 - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0);
+    const int index = (300 + k + 7) / 8;
+    return cached_powers[index];
+}
+
+inline
+int find_largest_pow10(uint32_t n, uint32_t& pow10)
+{
+    if (n >= 1000000000) { pow10 = 1000000000; return 10; }
+    if (n >= 100000000) { pow10 = 100000000; return 9; }
+    if (n >= 10000000) { pow10 = 10000000; return 8; }
+    if (n >= 1000000) { pow10 = 1000000; return 7; }
+    if (n >= 100000) { pow10 = 100000; return 6; }
+    if (n >= 10000) { pow10 = 10000; return 5; }
+    if (n >= 1000) { pow10 = 1000; return 4; }
+    if (n >= 100) { pow10 = 100; return 3; }
+    if (n >= 10) { pow10 = 10; return 2; }
+    pow10 = 1; 
+    return 1;
+}
+
+inline
+void grisu2_round(char* buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k)
+{
+    // Move the last digit down while that brings the result closer to w and keeps it in range
+    while (rest < dist && delta - rest >= ten_k && (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+        --buffer[length - 1];
+        rest += ten_k;
+    }
+}
+
+inline
+void grisu2_digit_gen(char* buffer, int& length, int& decimal_exponent,
+                      const diy_fp& m_minus, const diy_fp& w, const diy_fp& m_plus)
+{
+    uint64_t delta = diy_fp::sub(m_plus, m_minus).f;
+    uint64_t dist = diy_fp::sub(m_plus, w).f;
+
+    const diy_fp one(static_cast<uint64_t>(1) << -m_plus.e, m_plus.e);
+
+    uint32_t p1 = static_cast<uint32_t>(m_plus.f >> -one.e);
+    uint64_t p2 = m_plus.f & (one.f - 1);
+
+    uint32_t pow10;
+    int n = find_largest_pow10(p1, pow10);
+    while (n > 0)
+    {
+        const uint32_t d = p1 / pow10;
+        const uint32_t r = p1 % pow10;
+        buffer[length++] = static_cast<char>('0' + d);
+        p1 = r;
+        --n;
+
+        const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+        if (rest <= delta)
+        {
+            decimal_exponent += n;
+            grisu2_round(buffer, length, dist, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    for (;;)
+    {
+        p2 *= 10;
+        const uint64_t d = p2 >> -one.e;
+        const uint64_t r = p2 & (one.f - 1);
+        buffer[length++] = static_cast<char>('0' + d);
+        p2 = r;
+        ++m;
+
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta)
+        {
+            break;
+        }
+    }
+    decimal_exponent -= m;
+    grisu2_round(buffer, length, dist, delta, p2, one.f);
+}
+
+// Writes the digits of a finite, positive double v to buffer, so that v = digits*10^decimal_exponent.
+// At most 17 digits are written.
+inline
+void grisu2(double v, char* buffer, int& length, int& decimal_exponent)
+{
+    const uint64_t hidden_bit = static_cast<uint64_t>(1) << 52;
+    const int exponent_bias = 1023 + 52;
+
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const uint64_t biased_e = bits >> 52;
+    const uint64_t fraction = bits & (hidden_bit - 1);
+
+    const diy_fp w = biased_e == 0
+        ? diy_fp(fraction, 1 - exponent_bias)
+        : diy_fp(fraction + hidden_bit, static_cast<int>(biased_e) - exponent_bias);
+
+    // Boundaries m- and m+ halfway to the neighboring doubles
+    const bool lower_boundary_is_closer = fraction == 0 && biased_e > 1;
+    const diy_fp m_plus = diy_fp::normalize(diy_fp(2*w.f + 1, w.e - 1));
+    const diy_fp m_minus = diy_fp::normalize_to(lower_boundary_is_closer ? diy_fp(4*w.f - 1, w.e - 2) : diy_fp(2*w.f - 1, w.e - 1), m_plus.e);
+
+    const cached_power cached = get_cached_power(m_plus.e);
+    const diy_fp c_minus_k(cached.f, cached.e);
+
+    const diy_fp w_scaled = diy_fp::mul(diy_fp::normalize(w), c_minus_k);
+    const diy_fp w_minus = diy_fp::mul(m_minus, c_minus_k);
+    const diy_fp w_plus = diy_fp::mul(m_plus, c_minus_k);
+
+    // Shrink the interval by one ulp on each side to allow for the rounding in mul
+    const diy_fp lower(w_minus.f + 1, w_minus.e);
+    const diy_fp upper(w_plus.f - 1, w_plus.e);
+
+    length = 0;
+    decimal_exponent = -cached.k;
+    grisu2_digit_gen(buffer, length, decimal_exponent, lower, w_scaled, upper);
+}
+
+}}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_JSONWRAPPER_HPP
+#define JSONCONS_DETAIL_JSONWRAPPER_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <jsoncons/jsoncons_config.hpp>
+
+namespace jsoncons { namespace detail {
+
+// is_json_view
+
+// True for a view of an encoded value, such as cbor::cbor_view, whose at() returns a new view
+// rather than a reference into the value
+
+template <class Json, class Enable = void>
+struct is_json_view : std::false_type
+{
+};
+
+template <class Json>
+struct is_json_view<Json,typename std::enable_if<!std::is_reference<decltype(std::declval<Json>().at(typename Json::string_view_type()))>::value>::type> 
+    : std::true_type
+{
+};
+
+// json_wrapper
+
+// Holds a reference to a Json value as a pointer, or a view by value
+
+template <class Json,class JsonReference, class Enable = void>
+class json_wrapper
+{
+};
+
+template <class Json,class JsonReference>
+class json_wrapper<Json,JsonReference,typename std::enable_if<!is_json_view<Json>::value>::type>
+{
+public:
+    using reference = JsonReference;
+    using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
+
+    json_wrapper(reference ref) JSONCONS_NOEXCEPT
+        : ptr_(std::addressof(ref))
+    {
+    }
+
+    json_wrapper(const json_wrapper&) JSONCONS_NOEXCEPT = default;
+
+    json_wrapper& operator=(const json_wrapper&) JSONCONS_NOEXCEPT = default;
+
+    reference get() const JSONCONS_NOEXCEPT
+    {
+        return *ptr_;
+    }
+private:
+    pointer ptr_;
+};
+
+template <class Json,class JsonReference>
+class json_wrapper<Json,JsonReference,typename std::enable_if<is_json_view<Json>::value>::type>
+{
+public:
+    using value_type = typename Json::value_type;
+    using reference = JsonReference;
+    using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
+
+    json_wrapper(reference ref) JSONCONS_NOEXCEPT
+        : val_(ref)
+    {
+    }
+
+    json_wrapper(const json_wrapper& w) JSONCONS_NOEXCEPT
+        : val_(w.val_)
+    {
+    }
+
+    json_wrapper& operator=(const json_wrapper&) JSONCONS_NOEXCEPT = default;
+
+    value_type get() const JSONCONS_NOEXCEPT
+    {
+        return val_;
+    }
+private:
+    value_type val_;
+};
+
+}}
+
+#endif
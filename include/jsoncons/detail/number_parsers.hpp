@@ -21,10 +21,246 @@
 #include <type_traits>
 #include <algorithm>
 #include <exception>
+#include <cstring>
+#include <cstdint>
+#include <cfloat>
 #include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/detail/powers_of_ten.hpp>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace jsoncons { namespace detail {
 
+// Exact, locale independent conversion of the common case, up to 19 significant digits, 
+// using Clinger's fast path when the mantissa and power of ten are exactly representable, 
+// and otherwise the Eisel-Lemire algorithm (D. Lemire, "Number Parsing at a Gigabyte per Second", 2021). 
+// Returns false for inputs it can't decide, which are left to strtod.
+
+inline
+uint64_t multiply_64x64(uint64_t a, uint64_t b, uint64_t& high)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &high);
+#else
+    uint64_t a_lo = a & 0xffffffff;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffff;
+    uint64_t b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    high = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xffffffff);
+#endif
+}
+
+inline
+int count_leading_zeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while ((x & 0x8000000000000000ULL) == 0)
+    {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline
+bool eisel_lemire_to_double(uint64_t mantissa, int exp10, bool negative, double& result)
+{
+    if (exp10 < min_power_of_ten_128 || exp10 > max_power_of_ten_128)
+    {
+        return false;
+    }
+
+    // Normalize the mantissa and multiply by the 128 bit power of ten
+    int clz = count_leading_zeros(mantissa);
+    mantissa <<= clz;
+    uint64_t exp2 = static_cast<uint64_t>(((217706 * exp10) >> 16) + 64 + 1023) - static_cast<uint64_t>(clz);
+
+    const uint64_t* power = power_of_ten_128(exp10);
+    uint64_t x_hi;
+    uint64_t x_lo = multiply_64x64(mantissa, power[0], x_hi);
+
+    // The high 64 bits of the power weren't enough, take the low 64 bits into account
+    if ((x_hi & 0x1ff) == 0x1ff && x_lo + mantissa < mantissa)
+    {
+        uint64_t y_hi;
+        uint64_t y_lo = multiply_64x64(mantissa, power[1], y_hi);
+        uint64_t merged_hi = x_hi;
+        uint64_t merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo)
+        {
+            ++merged_hi;
+        }
+        if ((merged_hi & 0x1ff) == 0x1ff && merged_lo + 1 == 0 && y_lo + mantissa < mantissa)
+        {
+            return false;
+        }
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    // Shift to 54 bits
+    uint64_t msb = x_hi >> 63;
+    uint64_t significand = x_hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+
+    // Exactly halfway between two doubles, can't tell which way to round
+    if (x_lo == 0 && (x_hi & 0x1ff) == 0 && (significand & 3) == 1)
+    {
+        return false;
+    }
+
+    // Round to 53 bits
+    significand += significand & 1;
+    significand >>= 1;
+    if ((significand >> 53) > 0)
+    {
+        significand >>= 1;
+        exp2 += 1;
+    }
+
+    // Subnormal, infinite or NaN
+    if (exp2 - 1 >= 0x7ff - 1)
+    {
+        return false;
+    }
+
+    uint64_t bits = (exp2 << 52) | (significand & 0x000fffffffffffffULL);
+    if (negative)
+    {
+        bits |= 0x8000000000000000ULL;
+    }
+    std::memcpy(&result, &bits, sizeof(result));
+    return true;
+}
+
+inline
+bool try_decimal_to_double(const char* s, size_t length, char decimal_point, double& result)
+{
+    static const double exact_powers_of_ten[] = 
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* p = s;
+    const char* end = s + length;
+
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        ++p;
+    }
+
+    const char* digits_begin = p;
+    uint64_t mantissa = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+        mantissa = 10*mantissa + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    int64_t digit_count = p - digits_begin;
+    if (digit_count == 0)
+    {
+        return false;
+    }
+    int64_t exp10 = 0;
+    if (p != end && *p == decimal_point)
+    {
+        ++p;
+        const char* fraction_begin = p;
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            mantissa = 10*mantissa + static_cast<uint64_t>(*p - '0');
+            ++p;
+        }
+        if (p == fraction_begin)
+        {
+            return false;
+        }
+        exp10 = -(p - fraction_begin);
+        digit_count += (p - fraction_begin);
+    }
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '-' || *p == '+'))
+        {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9')
+        {
+            return false;
+        }
+        int64_t exponent = 0;
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            if (exponent < 0x10000)
+            {
+                exponent = 10*exponent + (*p - '0');
+            }
+            ++p;
+        }
+        exp10 += negative_exponent ? -exponent : exponent;
+    }
+    if (p != end)
+    {
+        return false;
+    }
+
+    if (digit_count > 19)
+    {
+        // Leading zeros are not significant
+        for (const char* q = digits_begin; q != end && (*q == '0' || *q == decimal_point); ++q)
+        {
+            if (*q == '0')
+            {
+                --digit_count;
+            }
+        }
+        if (digit_count > 19)
+        {
+            return false;
+        }
+    }
+
+    if (mantissa == 0)
+    {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (exp10 >= -22 && exp10 <= 22 && mantissa <= (static_cast<uint64_t>(1) << 53))
+    {
+        double d = static_cast<double>(mantissa);
+        d = exp10 < 0 ? d / exact_powers_of_ten[-exp10] : d * exact_powers_of_ten[exp10];
+        result = negative ? -d : d;
+        return true;
+    }
+#endif
+    if (exp10 < min_power_of_ten_128 || exp10 > max_power_of_ten_128)
+    {
+        return false;
+    }
+    return eisel_lemire_to_double(mantissa, static_cast<int>(exp10), negative, result);
+}
+
 #if defined(JSONCONS_HAS_MSC__STRTOD_L)
 
 class string_to_double
@@ -46,11 +282,16 @@ public:
         return '.';
     }
 
-    double operator()(const char* s, size_t) const
+    double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (try_decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         const char *begin = s;
         char *end = nullptr;
-        double val = _strtod_l(begin, &end, locale_);
+        val = _strtod_l(begin, &end, locale_);
         if (begin == end)
         {
             throw std::invalid_argument("Invalid float value");
@@ -86,9 +327,14 @@ public:
 
     double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (try_decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         const char *begin = s;
         char *end = nullptr;
-        double val = strtold_l(begin, &end, locale_);
+        val = strtold_l(begin, &end, locale_);
         if (begin == end)
         {
             throw std::invalid_argument("Invalid float value");
@@ -129,10 +375,15 @@ public:
         return decimal_point_;
     }
 
-    double operator()(const char* s, size_t /*length*/) const
+    double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (try_decimal_to_double(s, length, decimal_point_, val))
+        {
+            return val;
+        }
         char *end = nullptr;
-        double val = strtod(s, &end);
+        val = strtod(s, &end);
         if (s == end)
         {
             throw std::invalid_argument("string_to_double failed");
@@ -23,6 +23,7 @@
 #include <exception>
 #include <jsoncons/jsoncons_config.hpp>
 #include <jsoncons/detail/obufferedstream.hpp>
+#include <jsoncons/detail/grisu.hpp>
 
 namespace jsoncons { namespace detail {
 
@@ -70,6 +71,114 @@ void print_uinteger(uint64_t value, Writer& os)
     }
 }
 
+// print_shortest_double
+
+// Writes the shortest representation of a finite double that reads back to the same value, 
+// formatted like "%.15g" output in print_double: scientific notation when the decimal exponent 
+// is less than -4 or at least 15, and always with a decimal point.
+
+template<class Writer>
+void print_shortest_double(double val, Writer& writer)
+{
+    typedef typename Writer::char_type char_type;
+
+    char_type buf[32];
+    char_type* p = buf;
+
+    if (std::signbit(val))
+    {
+        *p++ = '-';
+        val = -val;
+    }
+    if (val == 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        *p++ = '0';
+        writer.write(buf, p - buf);
+        return;
+    }
+
+    char digits[18];
+    int length = 0;
+    int decimal_exponent = 0;
+    grisu2(val, digits, length, decimal_exponent);
+
+    // Exponent of the first digit
+    const int x = length + decimal_exponent - 1;
+
+    if (x < -4 || x >= std::numeric_limits<double>::digits10)
+    {
+        *p++ = digits[0];
+        *p++ = '.';
+        if (length == 1)
+        {
+            *p++ = '0';
+        }
+        for (int i = 1; i < length; ++i)
+        {
+            *p++ = digits[i];
+        }
+        *p++ = 'e';
+        int e = x;
+        if (e < 0)
+        {
+            *p++ = '-';
+            e = -e;
+        }
+        else
+        {
+            *p++ = '+';
+        }
+        if (e >= 100)
+        {
+            *p++ = static_cast<char_type>('0' + e/100);
+            e %= 100;
+        }
+        *p++ = static_cast<char_type>('0' + e/10);
+        *p++ = static_cast<char_type>('0' + e%10);
+    }
+    else if (x < 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = x + 1; i < 0; ++i)
+        {
+            *p++ = '0';
+        }
+        for (int i = 0; i < length; ++i)
+        {
+            *p++ = digits[i];
+        }
+    }
+    else if (length <= x + 1)
+    {
+        for (int i = 0; i < length; ++i)
+        {
+            *p++ = digits[i];
+        }
+        for (int i = length; i <= x; ++i)
+        {
+            *p++ = '0';
+        }
+        *p++ = '.';
+        *p++ = '0';
+    }
+    else
+    {
+        for (int i = 0; i <= x; ++i)
+        {
+            *p++ = digits[i];
+        }
+        *p++ = '.';
+        for (int i = x + 1; i < length; ++i)
+        {
+            *p++ = digits[i];
+        }
+    }
+    writer.write(buf, p - buf);
+}
+
 // print_double
 
 #if defined(JSONCONS_HAS__ECVT_S)
@@ -89,6 +198,12 @@ public:
     {
         typedef typename Writer::char_type char_type;
 
+        if (precision_override_ == 0 && precision == 0 && std::isfinite(val))
+        {
+            print_shortest_double(val, writer);
+            return;
+        }
+
         char buf[_CVTBUFSIZE];
         int decimal_point = 0;
         int sign = 0;
@@ -216,6 +331,12 @@ public:
     {
         typedef typename Writer::char_type char_type;
 
+        if (precision_override_ == 0 && precision == 0 && std::isfinite(val))
+        {
+            print_shortest_double(val, writer);
+            return;
+        }
+
         int prec;
         if (precision_override_ != 0)
         {
@@ -305,6 +426,12 @@ public:
     {
         typedef typename Writer::char_type char_type;
 
+        if (precision_override_ == 0 && precision == 0 && std::isfinite(val))
+        {
+            print_shortest_double(val, writer);
+            return;
+        }
+
         int prec;
         if (precision_override_ != 0)
         {
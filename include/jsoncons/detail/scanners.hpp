@@ -0,0 +1,305 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SCANNERS_HPP
+#define JSONCONS_DETAIL_SCANNERS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <jsoncons/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Block scanners for runs of characters that the parser and serializer would otherwise
+// examine one at a time. For char input they process 16 bytes per step with SSE2, or
+// 8 bytes per step with SWAR (SIMD within a register) arithmetic on other little endian
+// targets. Wider characters, and the tail of every run, go through the scalar loop.
+
+namespace jsoncons { namespace detail {
+
+inline
+unsigned count_trailing_zeros(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline
+unsigned count_trailing_zeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    uint32_t lo = static_cast<uint32_t>(x);
+    return lo != 0 ? count_trailing_zeros(lo) : 32 + count_trailing_zeros(static_cast<uint32_t>(x >> 32));
+#endif
+}
+
+#if defined(JSONCONS_HAS_SWAR)
+
+const uint64_t swar_ones = 0x0101010101010101ULL;
+const uint64_t swar_high_bits = 0x8080808080808080ULL;
+const uint64_t swar_low_bits = 0x7f7f7f7f7f7f7f7fULL;
+
+inline
+uint64_t swar_load(const char* p)
+{
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// Sets the high bit of every byte of word that equals c, and clears all other bits
+
+inline
+uint64_t swar_match(uint64_t word, unsigned char c)
+{
+    uint64_t v = word ^ (swar_ones * c);
+    return ~(((v & swar_low_bits) + swar_low_bits) | v | swar_low_bits);
+}
+
+#endif
+
+// Returns a pointer to the first character in [first,last) that is not a space or tab
+
+template <class CharT>
+const CharT* skip_blanks(const CharT* first, const CharT* last)
+{
+    while (first != last && (*first == ' ' || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+inline
+const char* skip_blanks(const char* first, const char* last)
+{
+#if defined(JSONCONS_HAS_SSE2)
+    const __m128i spaces = _mm_set1_epi8(' ');
+    const __m128i tabs = _mm_set1_epi8('\t');
+    while (last - first >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i blanks = _mm_or_si128(_mm_cmpeq_epi8(block, spaces), _mm_cmpeq_epi8(block, tabs));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(blanks)) ^ 0xffff;
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+#elif defined(JSONCONS_HAS_SWAR)
+    while (last - first >= 8)
+    {
+        uint64_t word = swar_load(first);
+        uint64_t mask = ~(swar_match(word, ' ') | swar_match(word, '\t')) & swar_high_bits;
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask)/8;
+        }
+        first += 8;
+    }
+#endif
+    while (first != last && (*first == ' ' || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+// Returns a pointer to the first character in [first,last) that cannot be copied
+// verbatim out of a JSON string literal: a quotation mark, a reverse solidus, or a
+// control character
+
+template <class CharT>
+const CharT* find_string_special(const CharT* first, const CharT* last)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    while (first != last && *first != '\"' && *first != '\\' && static_cast<uchar_type>(*first) >= 0x20)
+    {
+        ++first;
+    }
+    return first;
+}
+
+inline
+const char* find_string_special(const char* first, const char* last)
+{
+#if defined(JSONCONS_HAS_SSE2)
+    const __m128i quotes = _mm_set1_epi8('\"');
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    while (last - first >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quotes), _mm_cmpeq_epi8(block, backslashes)),
+                                       _mm_cmpeq_epi8(_mm_max_epu8(block, max_control), max_control));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+#elif defined(JSONCONS_HAS_SWAR)
+    while (last - first >= 8)
+    {
+        uint64_t word = swar_load(first);
+        uint64_t control = ~(((word & swar_low_bits) + swar_ones*(0x80-0x20)) | word) & swar_high_bits;
+        uint64_t mask = swar_match(word, '\"') | swar_match(word, '\\') | control;
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask)/8;
+        }
+        first += 8;
+    }
+#endif
+    while (first != last && *first != '\"' && *first != '\\' && static_cast<unsigned char>(*first) >= 0x20)
+    {
+        ++first;
+    }
+    return first;
+}
+
+// Returns a pointer to the first character in [first,last) that is outside the ASCII range
+
+template <class CharT>
+const CharT* skip_ascii(const CharT* first, const CharT* last)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    while (first != last && static_cast<uchar_type>(*first) < 0x80)
+    {
+        ++first;
+    }
+    return first;
+}
+
+inline
+const char* skip_ascii(const char* first, const char* last)
+{
+#if defined(JSONCONS_HAS_SSE2)
+    while (last - first >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+#elif defined(JSONCONS_HAS_SWAR)
+    while (last - first >= 8)
+    {
+        uint64_t mask = swar_load(first) & swar_high_bits;
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask)/8;
+        }
+        first += 8;
+    }
+#endif
+    while (first != last && static_cast<unsigned char>(*first) < 0x80)
+    {
+        ++first;
+    }
+    return first;
+}
+
+// Returns a pointer to the first character in [first,last) that a serializer must escape:
+// a quotation mark, a reverse solidus, a control character or DEL, and optionally a solidus 
+// or any character outside the ASCII range
+
+template <class CharT>
+const CharT* find_escape_special(const CharT* first, const CharT* last, bool escape_solidus, bool escape_non_ascii)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    for (; first != last; ++first)
+    {
+        uchar_type c = static_cast<uchar_type>(*first);
+        if (c == '\"' || c == '\\' || c <= 0x1f || c == 0x7f || (escape_solidus && c == '/') || (escape_non_ascii && c >= 0x80))
+        {
+            break;
+        }
+    }
+    return first;
+}
+
+inline
+const char* find_escape_special(const char* first, const char* last, bool escape_solidus, bool escape_non_ascii)
+{
+#if defined(JSONCONS_HAS_SSE2)
+    const __m128i quotes = _mm_set1_epi8('\"');
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    const __m128i deletes = _mm_set1_epi8(0x7f);
+    const __m128i solidus = escape_solidus ? _mm_set1_epi8('/') : quotes;
+    const uint32_t non_ascii_mask = escape_non_ascii ? 0xffff : 0;
+    while (last - first >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quotes), _mm_cmpeq_epi8(block, backslashes)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(_mm_max_epu8(block, max_control), max_control),
+                                                    _mm_or_si128(_mm_cmpeq_epi8(block, deletes), _mm_cmpeq_epi8(block, solidus))));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special)) 
+                      | (static_cast<uint32_t>(_mm_movemask_epi8(block)) & non_ascii_mask);
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+#elif defined(JSONCONS_HAS_SWAR)
+    const unsigned char solidus = escape_solidus ? '/' : '\"';
+    const uint64_t non_ascii_mask = escape_non_ascii ? swar_high_bits : 0;
+    while (last - first >= 8)
+    {
+        uint64_t word = swar_load(first);
+        uint64_t control = ~(((word & swar_low_bits) + swar_ones*(0x80-0x20)) | word) & swar_high_bits;
+        uint64_t mask = swar_match(word, '\"') | swar_match(word, '\\') | swar_match(word, 0x7f) 
+                      | swar_match(word, solidus) | control | (word & non_ascii_mask);
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask)/8;
+        }
+        first += 8;
+    }
+#endif
+    for (; first != last; ++first)
+    {
+        unsigned char c = static_cast<unsigned char>(*first);
+        if (c == '\"' || c == '\\' || c <= 0x1f || c == 0x7f || (escape_solidus && c == '/') || (escape_non_ascii && c >= 0x80))
+        {
+            break;
+        }
+    }
+    return first;
+}
+
+}}
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_THREAD_POOL_HPP
+#define JSONCONS_DETAIL_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <utility>
+
+namespace jsoncons { namespace detail {
+
+// A fixed set of worker threads taking tasks from one queue. The tasks given to it
+// by the parallel readers are large (a chunk of input each) so a single queue is not
+// contended. Destroying the pool discards tasks that have not started and waits for
+// the running ones.
+
+class thread_pool
+{
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_;
+
+    // Noncopyable and nonmoveable
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+public:
+    explicit thread_pool(size_t num_threads)
+        : stop_(false)
+    {
+        if (num_threads == 0)
+        {
+            num_threads = 1;
+        }
+        threads_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            threads_.emplace_back([this]{run();});
+        }
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_)
+        {
+            t.join();
+        }
+    }
+
+    size_t size() const
+    {
+        return threads_.size();
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    static size_t default_size()
+    {
+        size_t n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+private:
+    void run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]{return stop_ || !tasks_.empty();});
+                if (stop_)
+                {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+}}
+
+#endif
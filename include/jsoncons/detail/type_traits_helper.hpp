@@ -157,6 +157,14 @@ struct is_string_like<T,
                       typename std::enable_if<!std::is_void<typename T::traits_type>::value
 >::type> : std::true_type {};
 
+// is_std_basic_string
+
+template <class T>
+struct is_std_basic_string : std::false_type {};
+
+template <class CharT, class Traits, class Allocator>
+struct is_std_basic_string<std::basic_string<CharT,Traits,Allocator>> : std::true_type {};
+
 // is_integer_like
 
 template <class T, class Enable=void>
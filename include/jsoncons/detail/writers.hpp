@@ -110,22 +110,22 @@ private:
     }
 };
 
-template <class CharT>
+template <class CharT,class Traits=std::char_traits<CharT>,class Allocator=std::allocator<CharT>>
 class string_writer 
 {
 public:
     typedef basic_string_view_ext<CharT> string_view_type;
     typedef CharT char_type;
-    typedef std::basic_string<CharT> output_type;
+    typedef std::basic_string<CharT,Traits,Allocator> output_type;
 private:
-    std::basic_string<CharT>& s_;
+    output_type& s_;
 
     // Noncopyable and nonmoveable
     string_writer(const string_writer&) = delete;
     string_writer& operator=(const string_writer&) = delete;
 public:
 
-    string_writer(std::basic_string<CharT>& s)
+    string_writer(output_type& s)
         : s_(s)
     {
     }
@@ -0,0 +1,342 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_utilities.hpp>
+#include <jsoncons/json.hpp>
+
+namespace jsoncons {
+
+// key_intern_table
+
+// A process wide set of distinct object member names. Each name is stored once, with a
+// 32 bit id, and stays until the program exits. It is split into shards, each with its
+// own mutex, so that threads decoding in parallel rarely wait for each other.
+
+template <class CharT>
+class key_intern_table
+{
+public:
+    struct entry
+    {
+        const CharT* data;
+        size_t length;
+        size_t hash;
+        uint32_t id;
+    };
+private:
+    struct entry_hash
+    {
+        size_t operator()(const entry* e) const
+        {
+            return e->hash;
+        }
+    };
+
+    struct entry_equal
+    {
+        bool operator()(const entry* a, const entry* b) const
+        {
+            return a->length == b->length && std::char_traits<CharT>::compare(a->data, b->data, a->length) == 0;
+        }
+    };
+
+    static const size_t shard_count = 16;
+
+    struct shard
+    {
+        std::mutex mutex;
+        std::unordered_set<const entry*,entry_hash,entry_equal> entries;
+    };
+
+    shard shards_[shard_count];
+    std::atomic<uint32_t> next_id_;
+    std::atomic<size_t> bytes_;
+
+    key_intern_table()
+        : next_id_(0), bytes_(0)
+    {
+    }
+    key_intern_table(const key_intern_table&) = delete;
+    key_intern_table& operator=(const key_intern_table&) = delete;
+public:
+    ~key_intern_table()
+    {
+        for (auto& s : shards_)
+        {
+            for (const entry* e : s.entries)
+            {
+                ::operator delete(const_cast<entry*>(e));
+            }
+        }
+    }
+
+    static key_intern_table& instance()
+    {
+        static key_intern_table table;
+        return table;
+    }
+
+    static const entry* empty_entry()
+    {
+        static const CharT empty[1] = {0};
+        static const entry e = {empty, 0, hash_chars(empty, 0), 0};
+        return &e;
+    }
+
+    const entry* intern(const CharT* s, size_t length)
+    {
+        if (length == 0)
+        {
+            return empty_entry();
+        }
+        entry probe = {s, length, hash_chars(s, length), 0};
+        shard& sh = shards_[probe.hash % shard_count];
+
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        auto it = sh.entries.find(&probe);
+        if (it != sh.entries.end())
+        {
+            return *it;
+        }
+
+        // The characters follow the entry in the same block
+        size_t size = sizeof(entry) + (length + 1)*sizeof(CharT);
+        void* block = ::operator new(size);
+        CharT* p = reinterpret_cast<CharT*>(static_cast<char*>(block) + sizeof(entry));
+        std::char_traits<CharT>::copy(p, s, length);
+        p[length] = 0;
+        entry* e = ::new(block) entry{p, length, probe.hash, ++next_id_};
+        sh.entries.insert(e);
+        bytes_ += size;
+        return e;
+    }
+
+    // The number of distinct names
+    size_t size()
+    {
+        size_t count = 0;
+        for (auto& s : shards_)
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            count += s.entries.size();
+        }
+        return count;
+    }
+
+    // The memory taken by the names themselves, not counting the hash sets
+    size_t bytes() const
+    {
+        return bytes_;
+    }
+
+private:
+    static size_t hash_chars(const CharT* s, size_t length)
+    {
+        // FNV-1a
+        uint64_t h = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint64_t>(static_cast<typename std::make_unsigned<CharT>::type>(s[i]));
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+// interned_key
+
+// A key_storage for basic_json that holds a pointer to a name in the key_intern_table
+// instead of a string of its own. Constructing one looks the name up, and only allocates
+// the first time the name is seen. Copies and comparisons of two interned keys compare
+// pointers. The allocator is accepted for compatibility and not used.
+
+template <class CharT, class CharTraits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+class interned_key
+{
+public:
+    typedef CharT value_type;
+    typedef CharTraits traits_type;
+    typedef Allocator allocator_type;
+    typedef size_t size_type;
+    typedef const CharT* const_iterator;
+    typedef const CharT* iterator;
+    typedef basic_string_view_ext<CharT,CharTraits> string_view_type;
+    typedef typename key_intern_table<CharT>::entry entry_type;
+private:
+    const entry_type* entry_;
+public:
+    interned_key()
+        : entry_(key_intern_table<CharT>::empty_entry())
+    {
+    }
+
+    interned_key(const CharT* s, size_t length)
+        : entry_(key_intern_table<CharT>::instance().intern(s, length))
+    {
+    }
+
+    interned_key(const CharT* first, const CharT* last)
+        : entry_(key_intern_table<CharT>::instance().intern(first, last - first))
+    {
+    }
+
+    template <class A>
+    interned_key(const CharT* first, const CharT* last, const A&)
+        : entry_(key_intern_table<CharT>::instance().intern(first, last - first))
+    {
+    }
+
+    explicit interned_key(const string_view_type& s)
+        : entry_(key_intern_table<CharT>::instance().intern(s.data(), s.length()))
+    {
+    }
+
+    interned_key(const interned_key&) = default;
+    interned_key& operator=(const interned_key&) = default;
+
+    const CharT* data() const
+    {
+        return entry_->data;
+    }
+
+    const CharT* c_str() const
+    {
+        return entry_->data;
+    }
+
+    size_t size() const
+    {
+        return entry_->length;
+    }
+
+    size_t length() const
+    {
+        return entry_->length;
+    }
+
+    bool empty() const
+    {
+        return entry_->length == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return entry_->data;
+    }
+
+    const_iterator end() const
+    {
+        return entry_->data + entry_->length;
+    }
+
+    // The atom for this name, unique within the process, and 0 for the empty name
+    uint32_t id() const
+    {
+        return entry_->id;
+    }
+
+    size_t hash() const
+    {
+        return entry_->hash;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type();
+    }
+
+    void swap(interned_key& other) JSONCONS_NOEXCEPT
+    {
+        std::swap(entry_, other.entry_);
+    }
+
+    void shrink_to_fit()
+    {
+    }
+
+    int compare(const interned_key& other) const
+    {
+        return entry_ == other.entry_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+    }
+
+    operator string_view_type() const
+    {
+        return string_view_type(entry_->data, entry_->length);
+    }
+
+    friend bool operator==(const interned_key& lhs, const interned_key& rhs)
+    {
+        return lhs.entry_ == rhs.entry_;
+    }
+
+    friend bool operator!=(const interned_key& lhs, const interned_key& rhs)
+    {
+        return lhs.entry_ != rhs.entry_;
+    }
+
+    friend bool operator==(const interned_key& lhs, const string_view_type& rhs)
+    {
+        return string_view_type(lhs) == rhs;
+    }
+
+    friend bool operator==(const string_view_type& lhs, const interned_key& rhs)
+    {
+        return lhs == string_view_type(rhs);
+    }
+
+    friend bool operator!=(const interned_key& lhs, const string_view_type& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(const string_view_type& lhs, const interned_key& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const interned_key& lhs, const interned_key& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const interned_key& key)
+    {
+        return os << string_view_type(key);
+    }
+};
+
+struct interned_sorted_policy : public sorted_policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = interned_key<CharT, CharTraits, Allocator>;
+};
+
+struct interned_preserve_order_policy : public preserve_order_policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = interned_key<CharT, CharTraits, Allocator>;
+};
+
+typedef basic_json<char,interned_sorted_policy,std::allocator<char>> interned_json;
+typedef basic_json<wchar_t,interned_sorted_policy,std::allocator<wchar_t>> interned_wjson;
+typedef basic_json<char,interned_preserve_order_policy,std::allocator<char>> interned_ojson;
+typedef basic_json<wchar_t,interned_preserve_order_policy,std::allocator<wchar_t>> interned_wojson;
+
+}
+
+#endif
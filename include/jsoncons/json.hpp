@@ -26,6 +26,7 @@
 #include <jsoncons/json_serializer.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/mapped_file.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/json_error_category.hpp>
 #include <jsoncons/detail/heap_only_string.hpp>
@@ -41,6 +42,30 @@ struct sorted_policy
 {
     static const bool preserve_order = false;
 
+    // The tuning constants below may be left out of other policies, which then get
+    // these values.
+
+    // Objects that preserve order look members up with a hash index once they
+    // have this many, and by linear search below it. Zero turns the index off.
+    static const size_t object_hash_index_threshold = 32;
+
+    // Sorted objects keep a dense array of key prefixes to binary search once they
+    // have this many members. Zero turns the array off.
+    static const size_t object_key_prefix_threshold = 64;
+
+    // Sorted objects with this many members append new members unsorted, and merge
+    // them in later, rather than inserting each one in place. Zero, the default, turns
+    // this off. When it is on, the merge may happen on any lookup or iteration, const
+    // ones included, and invalidates iterators and references to members as an
+    // insertion does.
+    static const size_t object_append_buffer_threshold = 0;
+
+    // Arrays of at least this many integers, unsigned integers or doubles, all of one
+    // kind, may be stored packed, without a json value each. Zero, the default, turns
+    // this off. When it is on, a const read of a packed array by iterator or operator[]
+    // expands it under a lock and keeps the packed values as well.
+    static const size_t packed_array_threshold = 0;
+
     template <class T,class Allocator>
     using object_storage = std::vector<T,Allocator>;
 
@@ -795,6 +820,16 @@ public:
         }
 
         void Destroy_()
+        {
+            if (is_nested_(*this))
+            {
+                Destroy_nested_();
+            }
+            Destroy_flat_();
+        }
+
+        // Destroys the data, which must not have any nested arrays or objects left in it
+        void Destroy_flat_()
         {
             switch (type_id())
             {
@@ -815,6 +850,123 @@ public:
             }
         }
 
+        // Destroying an array or object destroys its elements, so a deeply nested value would
+        // recurse once per level. Instead, the nested arrays and objects below this one are
+        // visited depth first with an explicit stack, and each is destroyed once everything
+        // nested in it has been, when only scalars and empty containers are left in it.
+        void Destroy_nested_()
+        {
+            std::vector<std::pair<variant*,size_t>> stack;
+            variant* current = this;
+            size_t index = 0;
+            while (true)
+            {
+                variant* child = current->next_nested_(index);
+                if (child != nullptr)
+                {
+                    try
+                    {
+                        stack.emplace_back(current, index);
+                    }
+                    catch (...)
+                    {
+                        // The stack cannot grow, so what is left is destroyed without it
+                        Destroy_nested_without_stack_();
+                        return;
+                    }
+                    current = child;
+                    index = 0;
+                }
+                else if (!stack.empty())
+                {
+                    current->Destroy_flat_();
+                    new(reinterpret_cast<void*>(&current->data_))null_data();
+                    current = stack.back().first;
+                    index = stack.back().second;
+                    stack.pop_back();
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        // Destroys the nested arrays and objects below this one as Destroy_nested_ does, but
+        // finds each next one to destroy by descending from this value again. This allocates
+        // nothing, and takes time proportional to the depth for each, so it is only used when
+        // the stack cannot grow.
+        void Destroy_nested_without_stack_()
+        {
+            variant* current = this;
+            while (true)
+            {
+                size_t index = 0;
+                variant* child = current->next_nested_(index);
+                if (child != nullptr)
+                {
+                    current = child;
+                }
+                else if (current != this)
+                {
+                    current->Destroy_flat_();
+                    new(reinterpret_cast<void*>(&current->data_))null_data();
+                    current = this;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        static bool is_nested_(const variant& val)
+        {
+            switch (val.type_id())
+            {
+            case json_type_tag::object_t:
+                return val.object_data_cast()->value().size() > 0;
+            case json_type_tag::array_t:
+                return val.array_data_cast()->value().packing() == packed_kind::none &&
+                       val.array_data_cast()->value().size() > 0;
+            default:
+                return false;
+            }
+        }
+
+        // Returns the first nested element at or after index, and moves index past it. Members
+        // are visited as stored, since merging or sorting them here could throw.
+        variant* next_nested_(size_t& index)
+        {
+            if (type_id() == json_type_tag::object_t)
+            {
+                auto& members = object_data_cast()->value().storage();
+                auto last = members.end();
+                for (auto it = members.begin() + index; it != last; ++it)
+                {
+                    if (is_nested_(it->value().var_))
+                    {
+                        index = (it - members.begin()) + 1;
+                        return &(it->value().var_);
+                    }
+                }
+            }
+            else if (is_nested_(*this))
+            {
+                auto& elements = array_data_cast()->value();
+                auto last = elements.end();
+                for (auto it = elements.begin() + index; it != last; ++it)
+                {
+                    if (is_nested_(it->var_))
+                    {
+                        index = (it - elements.begin()) + 1;
+                        return &(it->var_);
+                    }
+                }
+            }
+            return nullptr;
+        }
+
         variant& operator=(const variant& val)
         {
             if (this !=&val)
@@ -2723,8 +2875,8 @@ public:
 
     static basic_json parse(const string_view_type& s, parse_error_handler& err_handler)
     {
-        json_decoder<basic_json> decoder;
-        basic_json_parser<char_type> parser(decoder,err_handler);
+        static_json_decoder<basic_json> decoder;
+        basic_json_parser<char_type,std::allocator<char>,static_json_decoder<basic_json>> parser(decoder,err_handler);
 
         auto result = unicons::skip_bom(s.begin(), s.end());
         if (result.ec != unicons::encoding_errc())
@@ -3038,7 +3190,7 @@ public:
     template <class SAllocator>
     void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s) const
     {
-        basic_json_serializer<char_type,detail::string_writer<char_type>> serializer(s);
+        basic_json_serializer<char_type,detail::string_writer<char_type,char_traits_type,SAllocator>> serializer(s);
         dump(serializer);
     }
 
@@ -3046,7 +3198,7 @@ public:
     void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s,
               const basic_serialization_options<char_type>& options) const
     {
-        basic_json_serializer<char_type,detail::string_writer<char_type>> serializer(s, options);
+        basic_json_serializer<char_type,detail::string_writer<char_type,char_traits_type,SAllocator>> serializer(s, options);
         dump(serializer);
     }
 
@@ -3102,9 +3254,16 @@ public:
             {
                 handler.begin_array();
                 const array& o = array_value();
-                for (const_array_iterator it = o.begin(); it != o.end(); ++it)
+                if (o.packing() != packed_kind::none)
                 {
-                    it->dump_fragment(handler);
+                    dump_packed(o, handler);
+                }
+                else
+                {
+                    for (const_array_iterator it = o.begin(); it != o.end(); ++it)
+                    {
+                        it->dump_fragment(handler);
+                    }
                 }
                 handler.end_array();
             }
@@ -3147,7 +3306,7 @@ public:
     string_type to_string(const char_allocator_type& allocator=char_allocator_type()) const JSONCONS_NOEXCEPT
     {
         string_type s(allocator);
-        basic_json_serializer<char_type,detail::string_writer<char_type>> serializer(s);
+        basic_json_serializer<char_type,detail::string_writer<char_type,char_traits_type,char_allocator_type>> serializer(s);
         dump_fragment(serializer);
         return s;
     }
@@ -3156,7 +3315,7 @@ public:
                           const char_allocator_type& allocator=char_allocator_type()) const
     {
         string_type s(allocator);
-        basic_json_serializer<char_type,detail::string_writer<char_type>> serializer(s,options);
+        basic_json_serializer<char_type,detail::string_writer<char_type,char_traits_type,char_allocator_type>> serializer(s,options);
         dump_fragment(serializer);
         return s;
     }
@@ -4385,8 +4544,7 @@ public:
     static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename,
                                  parse_error_handler& err_handler)
     {
-        std::basic_ifstream<CharT> is(filename);
-        return parse(is,err_handler);
+        return parse_file(filename, err_handler, std::is_same<char_type,char>());
     }
 
     static basic_json parse_stream(std::basic_istream<char_type>& is)
@@ -4776,6 +4934,69 @@ public:
 
 private:
 
+    static void dump_packed(const array& o, basic_json_output_handler<char_type>& handler)
+    {
+        const size_t n = o.size();
+        switch (o.packing())
+        {
+        case packed_kind::integer:
+            {
+                const int64_t* p = o.template packed_data<int64_t>();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    handler.integer_value(p[i]);
+                }
+            }
+            break;
+        case packed_kind::uinteger:
+            {
+                const uint64_t* p = o.template packed_data<uint64_t>();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    handler.uinteger_value(p[i]);
+                }
+            }
+            break;
+        default:
+            {
+                const double* p = o.template packed_data<double>();
+                const uint8_t* precisions = o.packed_precisions();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const uint8_t precision = precisions != nullptr ? precisions[i] : 0;
+                    handler.double_value(p[i], number_format(precision, precision));
+                }
+            }
+            break;
+        }
+    }
+
+#if !defined(JSONCONS_NO_DEPRECATED)
+    // Files of char are memory mapped and parsed in place, wide character files go through
+    // std::basic_ifstream, which converts them with its locale
+
+    static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename,
+                                 parse_error_handler& err_handler,
+                                 std::true_type)
+    {
+        std::error_code ec;
+        mapped_file file(filename, ec);
+        if (ec)
+        {
+            throw parse_error(json_parser_errc::source_error,1,1);
+        }
+        return parse(file.view(),err_handler);
+    }
+
+    static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename,
+                                 parse_error_handler& err_handler,
+                                 std::false_type)
+    {
+        std::basic_ifstream<CharT> is(filename);
+        return parse(is,err_handler);
+    }
+#endif
+
     friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_json& o)
     {
         o.dump(os);
@@ -0,0 +1,625 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_CURSOR_HPP
+#define JSONCONS_JSON_CURSOR_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <istream>
+#include <stdexcept>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_parser.hpp>
+
+namespace jsoncons {
+
+enum class json_event_type
+{
+    begin_object,
+    end_object,
+    begin_array,
+    end_array,
+    name,
+    string_value,
+    integer_value,
+    uinteger_value,
+    double_value,
+    bool_value,
+    null_value
+};
+
+template <class CharT>
+class basic_json_event
+{
+public:
+    typedef CharT char_type;
+    typedef std::char_traits<char_type> char_traits_type;
+    typedef basic_string_view_ext<char_type,char_traits_type> string_view_type;
+private:
+    json_event_type event_type_;
+    string_view_type string_value_;
+    union
+    {
+        int64_t int64_value_;
+        uint64_t uint64_value_;
+        double double_value_;
+        bool bool_value_;
+    } value_;
+    uint8_t precision_;
+public:
+    basic_json_event(json_event_type event_type)
+        : event_type_(event_type), precision_(0)
+    {
+        value_.int64_value_ = 0;
+    }
+
+    basic_json_event(json_event_type event_type, const string_view_type& s)
+        : event_type_(event_type), string_value_(s), precision_(0)
+    {
+        value_.int64_value_ = 0;
+    }
+
+    basic_json_event(int64_t value)
+        : event_type_(json_event_type::integer_value), precision_(0)
+    {
+        value_.int64_value_ = value;
+    }
+
+    basic_json_event(uint64_t value)
+        : event_type_(json_event_type::uinteger_value), precision_(0)
+    {
+        value_.uint64_value_ = value;
+    }
+
+    basic_json_event(double value, uint8_t precision)
+        : event_type_(json_event_type::double_value), precision_(precision)
+    {
+        value_.double_value_ = value;
+    }
+
+    basic_json_event(bool value)
+        : event_type_(json_event_type::bool_value), precision_(0)
+    {
+        value_.bool_value_ = value;
+    }
+
+    json_event_type event_type() const
+    {
+        return event_type_;
+    }
+
+    // For a double value, the number of significant digits it was written with
+
+    uint8_t precision() const
+    {
+        return precision_;
+    }
+
+    // Names and string values are views into the parser's source or string buffer,
+    // valid until the cursor next reads input or reaches the next string
+
+    string_view_type as_string_view() const
+    {
+        if (event_type_ != json_event_type::name && event_type_ != json_event_type::string_value)
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a string");
+        }
+        return string_value_;
+    }
+
+    std::basic_string<CharT> as_string() const
+    {
+        string_view_type s = as_string_view();
+        return std::basic_string<CharT>(s.data(), s.length());
+    }
+
+    int64_t as_integer() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return value_.int64_value_;
+        case json_event_type::uinteger_value:
+            return static_cast<int64_t>(value_.uint64_value_);
+        case json_event_type::double_value:
+            return static_cast<int64_t>(value_.double_value_);
+        case json_event_type::bool_value:
+            return value_.bool_value_ ? 1 : 0;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an integer");
+        }
+    }
+
+    uint64_t as_uinteger() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return static_cast<uint64_t>(value_.int64_value_);
+        case json_event_type::uinteger_value:
+            return value_.uint64_value_;
+        case json_event_type::double_value:
+            return static_cast<uint64_t>(value_.double_value_);
+        case json_event_type::bool_value:
+            return value_.bool_value_ ? 1 : 0;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an unsigned integer");
+        }
+    }
+
+    double as_double() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return static_cast<double>(value_.int64_value_);
+        case json_event_type::uinteger_value:
+            return static_cast<double>(value_.uint64_value_);
+        case json_event_type::double_value:
+            return value_.double_value_;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a double");
+        }
+    }
+
+    bool as_bool() const
+    {
+        if (event_type_ != json_event_type::bool_value)
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a bool");
+        }
+        return value_.bool_value_;
+    }
+};
+
+// basic_json_cursor
+
+// Pulls parse events one at a time, instead of pushing all of them into a
+// basic_json_input_handler. The source is an input stream, read in chunks of
+// buffer_length() characters, or a string that is parsed in place.
+
+template<class CharT,class Allocator=std::allocator<char>>
+class basic_json_cursor : private basic_json_input_handler<CharT>
+{
+    static const size_t default_max_buffer_length = 16384;
+public:
+    typedef CharT char_type;
+    typedef Allocator allocator_type;
+    typedef basic_json_event<CharT> event_type;
+    using typename basic_json_input_handler<CharT>::string_view_type;
+private:
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+
+    basic_json_parser<CharT,Allocator> parser_;
+    std::basic_istream<CharT>* is_;
+    bool eof_;
+    std::vector<CharT,char_allocator_type> buffer_;
+    size_t buffer_length_;
+    bool begin_;
+    event_type event_;
+    event_type pending_event_;
+    bool has_event_;
+    bool has_pending_event_;
+    bool done_;
+    size_t skip_depth_;
+
+    // Noncopyable and nonmoveable
+    basic_json_cursor(const basic_json_cursor&) = delete;
+    basic_json_cursor& operator=(const basic_json_cursor&) = delete;
+
+public:
+
+    basic_json_cursor(std::basic_istream<CharT>& is)
+        : parser_(*this),
+          is_(std::addressof(is)),
+          eof_(false),
+          buffer_length_(default_max_buffer_length),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        buffer_.reserve(buffer_length_);
+        next();
+    }
+
+    basic_json_cursor(std::basic_istream<CharT>& is,
+                      parse_error_handler& err_handler)
+        : parser_(*this,err_handler),
+          is_(std::addressof(is)),
+          eof_(false),
+          buffer_length_(default_max_buffer_length),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        buffer_.reserve(buffer_length_);
+        next();
+    }
+
+    basic_json_cursor(std::basic_istream<CharT>& is,
+                      std::error_code& ec)
+        : parser_(*this),
+          is_(std::addressof(is)),
+          eof_(false),
+          buffer_length_(default_max_buffer_length),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        buffer_.reserve(buffer_length_);
+        next(ec);
+    }
+
+    // The string must outlive the cursor, names and string values are views into it
+
+    basic_json_cursor(const string_view_type& s)
+        : parser_(*this),
+          is_(nullptr),
+          eof_(false),
+          buffer_length_(0),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        std::error_code ec;
+        set_string_source(s, ec);
+        if (ec)
+        {
+            throw parse_error(ec,1,1);
+        }
+        next();
+    }
+
+    basic_json_cursor(const string_view_type& s,
+                      parse_error_handler& err_handler)
+        : parser_(*this,err_handler),
+          is_(nullptr),
+          eof_(false),
+          buffer_length_(0),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        std::error_code ec;
+        set_string_source(s, ec);
+        if (ec)
+        {
+            throw parse_error(ec,1,1);
+        }
+        next();
+    }
+
+    basic_json_cursor(const string_view_type& s,
+                      std::error_code& ec)
+        : parser_(*this),
+          is_(nullptr),
+          eof_(false),
+          buffer_length_(0),
+          begin_(true),
+          event_(json_event_type::null_value),
+          pending_event_(json_event_type::null_value),
+          has_event_(false),
+          has_pending_event_(false),
+          done_(false),
+          skip_depth_(0)
+    {
+        set_string_source(s, ec);
+        if (ec) return;
+        next(ec);
+    }
+
+    size_t buffer_length() const
+    {
+        return buffer_length_;
+    }
+
+    void buffer_length(size_t length)
+    {
+        buffer_length_ = length;
+        buffer_.reserve(buffer_length_);
+    }
+
+    size_t max_nesting_depth() const
+    {
+        return parser_.max_nesting_depth();
+    }
+
+    void max_nesting_depth(size_t depth)
+    {
+        parser_.max_nesting_depth(depth);
+    }
+
+    size_t line_number() const
+    {
+        return parser_.line_number();
+    }
+
+    size_t column_number() const
+    {
+        return parser_.column_number();
+    }
+
+    // True when every event has been read, current() is then no longer meaningful
+
+    bool done() const
+    {
+        return done_;
+    }
+
+    const event_type& current() const
+    {
+        return event_;
+    }
+
+    void next()
+    {
+        std::error_code ec;
+        next(ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    void next(std::error_code& ec)
+    {
+        if (has_pending_event_)
+        {
+            event_ = pending_event_;
+            has_pending_event_ = false;
+            return;
+        }
+        has_event_ = false;
+        read_to_event(ec);
+        if (ec) return;
+        if (!has_event_)
+        {
+            done_ = true;
+        }
+    }
+
+    // If current() is begin_object or begin_array, moves to the matching end_object
+    // or end_array. The parser runs through the container without stopping and
+    // nothing inside it is reported. Otherwise does nothing.
+
+    void skip_subtree()
+    {
+        std::error_code ec;
+        skip_subtree(ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    void skip_subtree(std::error_code& ec)
+    {
+        if (done_ || (event_.event_type() != json_event_type::begin_object && event_.event_type() != json_event_type::begin_array))
+        {
+            return;
+        }
+        skip_depth_ = 1;
+        has_event_ = false;
+        read_to_event(ec);
+        skip_depth_ = 0;
+        if (ec) return;
+        if (!has_event_)
+        {
+            done_ = true;
+        }
+    }
+
+private:
+
+    void set_string_source(const string_view_type& s, std::error_code& ec)
+    {
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            ec = result.ec;
+            return;
+        }
+        size_t offset = result.it - s.begin();
+        parser_.set_source(s.data()+offset,s.size()-offset);
+        begin_ = false;
+    }
+
+    void read_buffer(std::error_code& ec)
+    {
+        buffer_.clear();
+        buffer_.resize(buffer_length_);
+        is_->read(buffer_.data(), buffer_length_);
+        buffer_.resize(static_cast<size_t>(is_->gcount()));
+        if (buffer_.size() == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            size_t offset = result.it - buffer_.begin();
+            parser_.set_source(buffer_.data()+offset,buffer_.size()-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.set_source(buffer_.data(),buffer_.size());
+        }
+    }
+
+    void read_to_event(std::error_code& ec)
+    {
+        while (!has_event_ && !eof_ && !parser_.done())
+        {
+            if (parser_.source_exhausted())
+            {
+                if (is_ != nullptr && !is_->eof())
+                {
+                    if (is_->fail())
+                    {
+                        ec = json_parser_errc::source_error;
+                        return;
+                    }
+                    read_buffer(ec);
+                    if (ec) return;
+                }
+                else
+                {
+                    eof_ = true;
+                }
+            }
+            if (!eof_)
+            {
+                parser_.parse(ec);
+                if (ec) return;
+            }
+        }
+        if (!has_event_ && eof_)
+        {
+            parser_.end_parse(ec);
+            if (ec) return;
+        }
+    }
+
+    void on_event(const event_type& event)
+    {
+        if (skip_depth_ > 0)
+        {
+            switch (event.event_type())
+            {
+            case json_event_type::begin_object:
+            case json_event_type::begin_array:
+                ++skip_depth_;
+                return;
+            case json_event_type::end_object:
+            case json_event_type::end_array:
+                if (--skip_depth_ > 0)
+                {
+                    return;
+                }
+                break;
+            default:
+                return;
+            }
+        }
+        if (!has_event_)
+        {
+            event_ = event;
+            has_event_ = true;
+            parser_.stop();
+        }
+        else
+        {
+            // A number closed by '}' or ']' reports two events in one step
+            pending_event_ = event;
+            has_pending_event_ = true;
+        }
+    }
+
+    void do_begin_json() override
+    {
+    }
+
+    void do_end_json() override
+    {
+    }
+
+    void do_begin_object(const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::begin_object));
+    }
+
+    void do_end_object(const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::end_object));
+    }
+
+    void do_begin_array(const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::begin_array));
+    }
+
+    void do_end_array(const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::end_array));
+    }
+
+    void do_name(const string_view_type& name, const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::name, name));
+    }
+
+    void do_null_value(const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::null_value));
+    }
+
+    void do_string_value(const string_view_type& value, const parsing_context&) override
+    {
+        on_event(event_type(json_event_type::string_value, value));
+    }
+
+    void do_byte_string_value(const uint8_t*, size_t, const parsing_context&) override
+    {
+        // Not produced by the JSON parser
+    }
+
+    void do_double_value(double value, const number_format& fmt, const parsing_context&) override
+    {
+        on_event(event_type(value, fmt.precision()));
+    }
+
+    void do_integer_value(int64_t value, const parsing_context&) override
+    {
+        on_event(event_type(value));
+    }
+
+    void do_uinteger_value(uint64_t value, const parsing_context&) override
+    {
+        on_event(event_type(value));
+    }
+
+    void do_bool_value(bool value, const parsing_context&) override
+    {
+        on_event(event_type(value));
+    }
+};
+
+typedef basic_json_cursor<char> json_cursor;
+typedef basic_json_cursor<wchar_t> wjson_cursor;
+
+}
+
+#endif
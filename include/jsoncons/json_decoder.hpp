@@ -15,12 +15,17 @@
 #include <memory>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/detail/type_traits_helper.hpp>
 
 namespace jsoncons {
 
+template <class Json,class Allocator=std::allocator<typename Json::char_type>>
+class static_json_decoder;
+
 template <class Json,class Allocator=std::allocator<typename Json::char_type>>
 class json_decoder : public basic_json_input_handler<typename Json::char_type>
 {
+    friend class static_json_decoder<Json,Allocator>;
 public:
     typedef typename Json::char_type char_type;
     using typename basic_json_input_handler<char_type>::string_view_type;
@@ -66,15 +71,26 @@ public:
     {
         size_t offset_;
         bool is_object_;
+        bool same_shape_;
     };
 
     typedef Allocator allocator_type;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<structure_offset> size_t_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_storage_type> key_storage_allocator_type;
+    typedef std::vector<key_storage_type,key_storage_allocator_type> shape_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<shape_type> shape_allocator_type;
 
 
     std::vector<stack_item,stack_item_allocator_type> stack_;
     std::vector<structure_offset,size_t_allocator_type> stack_offsets_;
+
+    // The member names of the last object completed at each depth. While an object's names
+    // match those of the one before it at the same depth, as in an array of records, they are
+    // copied from there, which for interned keys is a pointer copy rather than a table lookup.
+    // Copying a std::basic_string costs as much as making one, so those are never shared.
+    static const bool share_shapes = !detail::is_std_basic_string<key_storage_type>::value;
+    std::vector<shape_type,shape_allocator_type> shapes_;
     bool is_valid_;
 
 public:
@@ -119,7 +135,7 @@ private:
         {
             stack_.push_back(Json(object(object_allocator_)));
         }
-        stack_offsets_.push_back({stack_.size()-1,true});
+        stack_offsets_.push_back({stack_.size()-1,true,share_shapes});
     }
 
     void pop_object()
@@ -138,7 +154,7 @@ private:
         {
             stack_.push_back(Json(array(array_allocator_)));
         }
-        stack_offsets_.push_back({stack_.size()-1,false});
+        stack_offsets_.push_back({stack_.size()-1,false,false});
     }
 
     void pop_array()
@@ -151,7 +167,7 @@ private:
     {
         stack_offsets_.clear();
         stack_.clear();
-        stack_offsets_.push_back({0,false});
+        stack_offsets_.push_back({0,false,false});
         is_valid_ = false;
     }
 
@@ -198,6 +214,10 @@ private:
         auto last = first + count;
         if (stack_offsets_.back().is_object_)
         {
+            if (share_shapes)
+            {
+                update_shape(first, last);
+            }
             stack_[structure_index].value_.object_value().insert(
                 std::make_move_iterator(first),
                 std::make_move_iterator(last),
@@ -206,20 +226,58 @@ private:
         else
         {
             auto& j = stack_[structure_index].value_;
-            j.reserve(count);
-            while (first != last)
+            if (!j.array_value().pack(first, last, [](const stack_item& item) -> const Json& {return item.value_;}))
             {
-                j.push_back(std::move(first->value_));
-                ++first;
+                j.reserve(count);
+                while (first != last)
+                {
+                    j.push_back(std::move(first->value_));
+                    ++first;
+                }
             }
         }
     }
 
     void do_name(const string_view_type& name, const parsing_context&) override
     {
+        structure_offset& structure = stack_offsets_.back();
+        if (structure.same_shape_)
+        {
+            const size_t depth = stack_offsets_.size() - 1;
+            const size_t index = stack_.size() - (structure.offset_ + 1);
+            if (depth < shapes_.size() && index < shapes_[depth].size())
+            {
+                const key_storage_type& key = shapes_[depth][index];
+                if (string_view_type(key.data(),key.size()) == name)
+                {
+                    stack_.push_back(key_storage_type(key));
+                    return;
+                }
+            }
+            structure.same_shape_ = false;
+        }
         stack_.push_back(key_storage_type(name.begin(),name.end(),string_allocator_));
     }
 
+    template <class Iterator>
+    void update_shape(Iterator first, Iterator last)
+    {
+        const size_t depth = stack_offsets_.size() - 1;
+        if (depth >= shapes_.size())
+        {
+            shapes_.resize(depth + 1);
+        }
+        shape_type& shape = shapes_[depth];
+        if (!stack_offsets_.back().same_shape_ || shape.size() != static_cast<size_t>(last - first))
+        {
+            shape.clear();
+            for (auto it = first; it != last; ++it)
+            {
+                shape.push_back(it->name_);
+            }
+        }
+    }
+
     void do_string_value(const string_view_type& val, const parsing_context&) override
     {
         if (stack_offsets_.back().is_object_)
@@ -305,6 +363,101 @@ private:
     }
 };
 
+// static_json_decoder
+
+// A json_decoder for basic_json_parser<CharT,Allocator,static_json_decoder<Json>>, which calls
+// its event functions directly rather than through basic_json_input_handler. They hide those
+// of the base class, and call the json_decoder overrides by name, so it cannot be derived from.
+// To override events, derive from json_decoder and use the parser's default Handler.
+
+template <class Json,class Allocator>
+class static_json_decoder final : public json_decoder<Json,Allocator>
+{
+    typedef json_decoder<Json,Allocator> base_type;
+public:
+    typedef typename base_type::char_type char_type;
+    using typename base_type::string_view_type;
+    using typename base_type::json_allocator_type;
+
+    static_json_decoder(const json_allocator_type& jallocator = json_allocator_type())
+        : base_type(jallocator)
+    {
+    }
+
+    using basic_json_input_handler<char_type>::name;
+    using basic_json_input_handler<char_type>::double_value;
+
+    void begin_json()
+    {
+        base_type::do_begin_json();
+    }
+
+    void end_json()
+    {
+        base_type::do_end_json();
+    }
+
+    void begin_object(const parsing_context& context)
+    {
+        base_type::do_begin_object(context);
+    }
+
+    void end_object(const parsing_context& context)
+    {
+        base_type::do_end_object(context);
+    }
+
+    void begin_array(const parsing_context& context)
+    {
+        base_type::do_begin_array(context);
+    }
+
+    void end_array(const parsing_context& context)
+    {
+        base_type::do_end_array(context);
+    }
+
+    void name(const string_view_type& name, const parsing_context& context)
+    {
+        base_type::do_name(name, context);
+    }
+
+    void string_value(const string_view_type& value, const parsing_context& context)
+    {
+        base_type::do_string_value(value, context);
+    }
+
+    void byte_string_value(const uint8_t* data, size_t length, const parsing_context& context)
+    {
+        base_type::do_byte_string_value(data, length, context);
+    }
+
+    void integer_value(int64_t value, const parsing_context& context)
+    {
+        base_type::do_integer_value(value, context);
+    }
+
+    void uinteger_value(uint64_t value, const parsing_context& context)
+    {
+        base_type::do_uinteger_value(value, context);
+    }
+
+    void double_value(double value, const number_format& fmt, const parsing_context& context)
+    {
+        base_type::do_double_value(value, fmt, context);
+    }
+
+    void bool_value(bool value, const parsing_context& context)
+    {
+        base_type::do_bool_value(value, context);
+    }
+
+    void null_value(const parsing_context& context)
+    {
+        base_type::do_null_value(context);
+    }
+};
+
 }
 
 #endif
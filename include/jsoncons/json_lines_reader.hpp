@@ -0,0 +1,413 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/thread_pool.hpp>
+
+namespace jsoncons {
+
+// json_lines_reader
+
+// Reads newline delimited JSON (JSON Lines), one JSON text per line, on a pool of worker
+// threads. The input, a string (for example a mapped_file) or a stream, is split into chunks
+// of about chunk_length() characters that end at a newline, and each chunk is parsed by a
+// worker with its own parser and decoder. The values are passed to the callback on the
+// calling thread, in input order if ordered() is true (the default), otherwise as chunks
+// complete. Blank lines are skipped. A parse_error_handler given to the reader is shared
+// by the workers and must be thread safe.
+
+template <class Json>
+class json_lines_reader
+{
+public:
+    typedef typename Json::char_type char_type;
+    typedef std::char_traits<char_type> char_traits_type;
+    typedef basic_string_view_ext<char_type,char_traits_type> string_view_type;
+private:
+    static const size_t default_chunk_length = 1024*1024;
+
+    struct chunk
+    {
+        chunk()
+            : first(nullptr), last(nullptr), first_line(0),
+              error_line(0), error_column(0), done(false)
+        {
+        }
+
+        std::basic_string<char_type> buffer;
+        const char_type* first;
+        const char_type* last;
+        size_t first_line;
+        std::vector<Json> values;
+        std::error_code ec;
+        size_t error_line;
+        size_t error_column;
+        std::exception_ptr exception;
+        bool done;
+    };
+
+    default_parse_error_handler default_err_handler_;
+    parse_error_handler& err_handler_;
+    std::basic_istream<char_type>* is_;
+    const char_type* input_ptr_;
+    const char_type* input_end_;
+    bool begin_;
+    size_t line_;
+    size_t num_threads_;
+    size_t chunk_length_;
+    bool ordered_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Noncopyable and nonmoveable
+    json_lines_reader(const json_lines_reader&) = delete;
+    json_lines_reader& operator=(const json_lines_reader&) = delete;
+
+public:
+    // The string must outlive the call to read
+
+    json_lines_reader(const string_view_type& s)
+        : err_handler_(default_err_handler_),
+          is_(nullptr),
+          input_ptr_(s.data()),
+          input_end_(s.data()+s.length()),
+          begin_(true),
+          line_(1),
+          num_threads_(detail::thread_pool::default_size()),
+          chunk_length_(default_chunk_length),
+          ordered_(true)
+    {
+    }
+
+    json_lines_reader(const string_view_type& s,
+                      parse_error_handler& err_handler)
+        : err_handler_(err_handler),
+          is_(nullptr),
+          input_ptr_(s.data()),
+          input_end_(s.data()+s.length()),
+          begin_(true),
+          line_(1),
+          num_threads_(detail::thread_pool::default_size()),
+          chunk_length_(default_chunk_length),
+          ordered_(true)
+    {
+    }
+
+    json_lines_reader(std::basic_istream<char_type>& is)
+        : err_handler_(default_err_handler_),
+          is_(std::addressof(is)),
+          input_ptr_(nullptr),
+          input_end_(nullptr),
+          begin_(true),
+          line_(1),
+          num_threads_(detail::thread_pool::default_size()),
+          chunk_length_(default_chunk_length),
+          ordered_(true)
+    {
+    }
+
+    json_lines_reader(std::basic_istream<char_type>& is,
+                      parse_error_handler& err_handler)
+        : err_handler_(err_handler),
+          is_(std::addressof(is)),
+          input_ptr_(nullptr),
+          input_end_(nullptr),
+          begin_(true),
+          line_(1),
+          num_threads_(detail::thread_pool::default_size()),
+          chunk_length_(default_chunk_length),
+          ordered_(true)
+    {
+    }
+
+    size_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    void num_threads(size_t value)
+    {
+        num_threads_ = value > 0 ? value : 1;
+    }
+
+    size_t chunk_length() const
+    {
+        return chunk_length_;
+    }
+
+    void chunk_length(size_t value)
+    {
+        chunk_length_ = value > 0 ? value : 1;
+    }
+
+    bool ordered() const
+    {
+        return ordered_;
+    }
+
+    void ordered(bool value)
+    {
+        ordered_ = value;
+    }
+
+    // Calls callback(Json&&) with each value
+
+    template <class Callback>
+    void read(Callback callback)
+    {
+        std::error_code ec;
+        size_t line = 0;
+        size_t column = 0;
+        read(callback, ec, line, column);
+        if (ec)
+        {
+            throw parse_error(ec,line,column);
+        }
+    }
+
+    template <class Callback>
+    void read(Callback callback, std::error_code& ec)
+    {
+        size_t line = 0;
+        size_t column = 0;
+        read(callback, ec, line, column);
+    }
+
+private:
+
+    template <class Callback>
+    void read(Callback callback, std::error_code& ec, size_t& error_line, size_t& error_column)
+    {
+        const size_t max_in_flight = 2*num_threads_;
+
+        std::deque<std::shared_ptr<chunk>> in_flight;
+        bool more = true;
+
+        // Declared after in_flight so that its workers are joined before the chunks are released
+        detail::thread_pool pool(num_threads_);
+
+        for (;;)
+        {
+            while (more && in_flight.size() < max_in_flight)
+            {
+                std::shared_ptr<chunk> c = std::make_shared<chunk>();
+                more = next_chunk(*c, ec);
+                if (ec)
+                {
+                    error_line = line_;
+                    error_column = 1;
+                    return;
+                }
+                if (more)
+                {
+                    in_flight.push_back(c);
+                    pool.submit([this,c]{parse_chunk(*c);});
+                }
+            }
+            if (in_flight.empty())
+            {
+                break;
+            }
+
+            std::shared_ptr<chunk> c;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (ordered_)
+                {
+                    cv_.wait(lock, [&]{return in_flight.front()->done;});
+                    c = in_flight.front();
+                    in_flight.pop_front();
+                }
+                else
+                {
+                    typename std::deque<std::shared_ptr<chunk>>::iterator it;
+                    cv_.wait(lock, [&]
+                    {
+                        it = std::find_if(in_flight.begin(), in_flight.end(),
+                                          [](const std::shared_ptr<chunk>& p){return p->done;});
+                        return it != in_flight.end();
+                    });
+                    c = *it;
+                    in_flight.erase(it);
+                }
+            }
+
+            if (c->exception)
+            {
+                std::rethrow_exception(c->exception);
+            }
+            for (auto& val : c->values)
+            {
+                callback(std::move(val));
+            }
+            if (c->ec)
+            {
+                ec = c->ec;
+                error_line = c->error_line;
+                error_column = c->error_column;
+                return;
+            }
+        }
+    }
+
+    bool next_chunk(chunk& c, std::error_code& ec)
+    {
+        if (is_ == nullptr)
+        {
+            if (begin_)
+            {
+                begin_ = false;
+                auto result = unicons::skip_bom(input_ptr_, input_end_);
+                if (result.ec != unicons::encoding_errc())
+                {
+                    ec = result.ec;
+                    return false;
+                }
+                input_ptr_ = result.it;
+            }
+            if (input_ptr_ == input_end_)
+            {
+                return false;
+            }
+            c.first = input_ptr_;
+            c.last = static_cast<size_t>(input_end_ - input_ptr_) > chunk_length_ ? input_ptr_ + chunk_length_ : input_end_;
+            if (c.last != input_end_)
+            {
+                c.last = std::find(c.last, input_end_, '\n');
+                if (c.last != input_end_)
+                {
+                    ++c.last;
+                }
+            }
+            input_ptr_ = c.last;
+        }
+        else
+        {
+            if (is_->eof())
+            {
+                return false;
+            }
+            if (is_->fail())
+            {
+                ec = json_parser_errc::source_error;
+                return false;
+            }
+            c.buffer.resize(chunk_length_);
+            is_->read(&c.buffer[0], chunk_length_);
+            c.buffer.resize(static_cast<size_t>(is_->gcount()));
+            if (!is_->eof())
+            {
+                // Complete the last line
+                std::basic_string<char_type> rest;
+                std::getline(*is_, rest);
+                c.buffer.append(rest);
+                c.buffer.push_back('\n');
+            }
+            if (begin_)
+            {
+                begin_ = false;
+                auto result = unicons::skip_bom(c.buffer.begin(), c.buffer.end());
+                if (result.ec != unicons::encoding_errc())
+                {
+                    ec = result.ec;
+                    return false;
+                }
+                c.buffer.erase(c.buffer.begin(), result.it);
+            }
+            if (c.buffer.empty())
+            {
+                return !is_->eof();
+            }
+            c.first = c.buffer.data();
+            c.last = c.buffer.data() + c.buffer.length();
+        }
+        c.first_line = line_;
+        line_ += std::count(c.first, c.last, '\n');
+        return true;
+    }
+
+    void parse_chunk(chunk& c)
+    {
+        try
+        {
+            static_json_decoder<Json> decoder;
+            basic_json_parser<char_type,std::allocator<char>,static_json_decoder<Json>> parser(decoder, err_handler_);
+
+            size_t line = c.first_line;
+            const char_type* p = c.first;
+            while (p != c.last)
+            {
+                const char_type* eol = std::find(p, c.last, '\n');
+                if (!is_blank(p, eol))
+                {
+                    std::error_code ec;
+                    parser.reset();
+                    parser.set_source(p, eol - p);
+                    parser.parse(ec);
+                    if (!ec)
+                    {
+                        parser.end_parse(ec);
+                    }
+                    if (!ec)
+                    {
+                        parser.check_done(ec);
+                    }
+                    if (ec)
+                    {
+                        c.ec = ec;
+                        c.error_line = line + parser.line_number() - 1;
+                        c.error_column = parser.column_number();
+                        break;
+                    }
+                    c.values.push_back(decoder.get_result());
+                }
+                ++line;
+                p = eol == c.last ? eol : eol + 1;
+            }
+        }
+        catch (...)
+        {
+            c.exception = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            c.done = true;
+        }
+        cv_.notify_all();
+    }
+
+    static bool is_blank(const char_type* first, const char_type* last)
+    {
+        for (; first != last; ++first)
+        {
+            if (!(*first == ' ' || *first == '\t' || *first == '\r'))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}
+
+#endif
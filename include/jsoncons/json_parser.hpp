@@ -20,6 +20,7 @@
 #include <jsoncons/parse_error_handler.hpp>
 #include <jsoncons/json_error_category.hpp>
 #include <jsoncons/detail/number_parsers.hpp>
+#include <jsoncons/detail/scanners.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -82,7 +83,12 @@ enum class parse_state : uint8_t
     done
 };
 
-template <class CharT, class Allocator = std::allocator<char>>
+// Events are passed to a Handler, by default any basic_json_input_handler through its virtual
+// interface. A concrete Handler type that declares its own event functions (begin_object, name,
+// string_value, ...), such as static_json_decoder<Json>, is called directly, and they can be
+// inlined into the parser.
+
+template <class CharT, class Allocator = std::allocator<char>, class Handler = basic_json_input_handler<CharT>>
 class basic_json_parser : private parsing_context
 {
     static const size_t initial_string_buffer_capacity_ = 1024;
@@ -93,7 +99,7 @@ class basic_json_parser : private parsing_context
     basic_null_json_input_handler<CharT> default_input_handler_;
     default_parse_error_handler default_err_handler_;
 
-    basic_json_input_handler<CharT>& handler_;
+    Handler& handler_;
     parse_error_handler& err_handler_;
     uint32_t cp_;
     uint32_t cp2_;
@@ -121,6 +127,7 @@ class basic_json_parser : private parsing_context
     const CharT* input_ptr_;
 
     parse_state state_;
+    bool continue_;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<parse_state> parse_state_allocator_type;
     std::vector<parse_state,parse_state_allocator_type> state_stack_;
 
@@ -145,7 +152,8 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -170,7 +178,8 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -180,7 +189,7 @@ public:
         push_state(parse_state::root);
     }
 
-    basic_json_parser(basic_json_input_handler<CharT>& handler)
+    basic_json_parser(Handler& handler)
        : handler_(handler),
          err_handler_(default_err_handler_),
          cp_(0),
@@ -195,7 +204,8 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -205,7 +215,7 @@ public:
         push_state(parse_state::root);
     }
 
-    basic_json_parser(basic_json_input_handler<CharT>& handler,
+    basic_json_parser(Handler& handler,
                       parse_error_handler& err_handler)
        : handler_(handler),
          err_handler_(err_handler),
@@ -221,7 +231,8 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -281,23 +292,59 @@ public:
         return state_ == parse_state::done;
     }
 
+    // Makes the current call to parse return after the event being reported,
+    // leaving the rest of the source for the next call
+    void stop()
+    {
+        continue_ = false;
+    }
+
     void skip_whitespace()
     {
         const CharT* local_input_end = input_end_;
         for (;;) 
         {
+            const CharT* p = detail::skip_blanks(input_ptr_, local_input_end);
+            column_ += (p - input_ptr_);
+            input_ptr_ = p;
             if (JSONCONS_UNLIKELY(input_ptr_ == local_input_end)) 
             {
                 return;
             } 
-            else if (*input_ptr_ == ' ' || *input_ptr_ == '\t') 
-            {
-                ++input_ptr_;
-                ++column_;                     
-            } 
-            else 
+            switch (*input_ptr_)
             {
-                return;
+                case '\n':
+                    ++input_ptr_;
+                    ++column_;
+                    if (input_ptr_ == local_input_end)
+                    {
+                        // Count the line when the next chunk arrives
+                        push_state(state_);
+                        state_ = parse_state::lf;
+                        return;
+                    }
+                    ++line_;
+                    column_ = 1;
+                    break;
+                case '\r':
+                    ++input_ptr_;
+                    ++column_;
+                    if (input_ptr_ == local_input_end)
+                    {
+                        // A following '\n' may start the next chunk
+                        push_state(state_);
+                        state_ = parse_state::cr;
+                        return;
+                    }
+                    if (*input_ptr_ == '\n')
+                    {
+                        ++input_ptr_;
+                    }
+                    ++line_;
+                    column_ = 1;
+                    break;
+                default:
+                    return;
             }
         }
     }
@@ -451,8 +498,9 @@ public:
     void parse(std::error_code& ec)
     {
         const CharT* local_input_end = input_end_;
+        continue_ = true;
 
-        while ((input_ptr_ < local_input_end) && (state_ != parse_state::done))
+        while ((input_ptr_ < local_input_end) && (state_ != parse_state::done) && continue_)
         {
             switch (state_)
             {
@@ -487,19 +535,7 @@ public:
                                 return;
                             }
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -521,6 +557,7 @@ public:
                             ++column_;
                             break;
                         case '\"':
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             ++input_ptr_;
                             ++column_;
@@ -595,19 +632,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/':
@@ -670,19 +695,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/':
@@ -701,6 +714,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             push_state(parse_state::member_name);
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '\'':
@@ -737,19 +751,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -762,6 +764,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             push_state(parse_state::member_name);
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '}':
@@ -809,19 +812,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            ++input_ptr_;
-                            ++column_;
-                            break; 
-                        case '\n': 
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            ++input_ptr_;
-                            ++column_;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -861,19 +852,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -897,6 +876,7 @@ public:
                         case '\"':
                             ++input_ptr_;
                             ++column_;
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '-':
@@ -996,19 +976,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case '\r':case '\n':case ' ':case '\t':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -1038,6 +1006,7 @@ public:
                         case '\"':
                             ++input_ptr_;
                             ++column_;
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '-':
@@ -2147,6 +2116,11 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
@@ -2159,7 +2133,7 @@ string_u1:
                         return;
                     }
                     // recovery - skip
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2181,7 +2155,7 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2204,7 +2178,7 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2227,7 +2201,7 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2241,7 +2215,7 @@ string_u1:
                 }
                 case '\\': 
                 {
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2255,7 +2229,7 @@ string_u1:
                 }
                 case '\"':
                 {
-                    auto result = unicons::validate(sb,input_ptr_);
+                    auto result = validate_string(sb,input_ptr_);
                     if (result.ec != unicons::conv_errc())
                     {
                         translate_conv_errc(result.ec,ec);
@@ -2271,7 +2245,6 @@ string_u1:
                     {
                         string_buffer_.append(sb,input_ptr_-sb);
                         end_string_value(string_buffer_.data(),string_buffer_.length(), ec);
-                        string_buffer_.clear();
                         if (ec) {return;}
                     }
                     column_ += (input_ptr_ - sb + 1);
@@ -2286,7 +2259,7 @@ string_u1:
 
         // Buffer exhausted               
         {
-            auto result = unicons::validate(sb,input_ptr_);
+            auto result = validate_string(sb,input_ptr_);
             if (result.ec != unicons::conv_errc())
             {
                 translate_conv_errc(result.ec,ec);
@@ -2883,6 +2856,12 @@ private:
         }
     }
 
+    static unicons::convert_result<const CharT*> validate_string(const CharT* first, const CharT* last)
+    {
+        // Only the characters from the first non-ASCII one on need decoding
+        return unicons::validate(detail::skip_ascii(first, last), last);
+    }
+
     void end_string_value(const CharT* s, size_t length, std::error_code& ec) 
     {
         switch (parent())
@@ -144,9 +144,10 @@ class basic_json_reader
     typedef CharT char_type;
     typedef Allocator allocator_type;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+    typedef typename basic_json_input_handler<CharT>::string_view_type string_view_type;
 
     basic_json_parser<CharT,Allocator> parser_;
-    std::basic_istream<CharT>& is_;
+    std::basic_istream<CharT>* is_;
     bool eof_;
     std::vector<CharT,char_allocator_type> buffer_;
     size_t buffer_length_;
@@ -160,7 +161,7 @@ public:
 
     basic_json_reader(std::basic_istream<CharT>& is)
         : parser_(),
-          is_(is),
+          is_(std::addressof(is)),
           eof_(false),
           buffer_length_(default_max_buffer_length),
           begin_(true)
@@ -171,7 +172,7 @@ public:
     basic_json_reader(std::basic_istream<CharT>& is,
                       parse_error_handler& err_handler)
        : parser_(err_handler),
-         is_(is),
+         is_(std::addressof(is)),
          eof_(false),
          buffer_length_(default_max_buffer_length),
          begin_(true)
@@ -182,7 +183,7 @@ public:
     basic_json_reader(std::basic_istream<CharT>& is, 
                       basic_json_input_handler<CharT>& handler)
         : parser_(handler),
-          is_(is),
+          is_(std::addressof(is)),
           eof_(false),
           buffer_length_(default_max_buffer_length),
           begin_(true)
@@ -194,7 +195,7 @@ public:
                       basic_json_input_handler<CharT>& handler,
                       parse_error_handler& err_handler)
        : parser_(handler,err_handler),
-         is_(is),
+         is_(std::addressof(is)),
          eof_(false),
          buffer_length_(default_max_buffer_length),
          begin_(true)
@@ -202,6 +203,33 @@ public:
         buffer_.reserve(buffer_length_);
     }
 
+    // Reads the text in s in place, without copying it into a buffer. Names and string values
+    // without escapes are passed to the handler as views into s, which must outlive the reader.
+    // A mapped_file can be read this way in a single pass.
+
+    basic_json_reader(const string_view_type& s, 
+                      basic_json_input_handler<CharT>& handler)
+        : parser_(handler),
+          is_(nullptr),
+          eof_(false),
+          buffer_length_(default_max_buffer_length),
+          begin_(true)
+    {
+        set_string_source(s);
+    }
+
+    basic_json_reader(const string_view_type& s,
+                      basic_json_input_handler<CharT>& handler,
+                      parse_error_handler& err_handler)
+       : parser_(handler,err_handler),
+         is_(nullptr),
+         eof_(false),
+         buffer_length_(default_max_buffer_length),
+         begin_(true)
+    {
+        set_string_source(s);
+    }
+
     size_t buffer_length() const
     {
         return buffer_length_;
@@ -210,7 +238,10 @@ public:
     void buffer_length(size_t length)
     {
         buffer_length_ = length;
-        buffer_.reserve(buffer_length_);
+        if (is_ != nullptr)
+        {
+            buffer_.reserve(buffer_length_);
+        }
     }
 
     size_t max_nesting_depth() const
@@ -233,12 +264,19 @@ public:
         }
     }
 
+    // Reads the next block of the stream. A reader of a string has no stream, and is at
+    // its end.
     void read_buffer(std::error_code& ec)
     {
+        if (is_ == nullptr)
+        {
+            eof_ = true;
+            return;
+        }
         buffer_.clear();
         buffer_.resize(buffer_length_);
-        is_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<size_t>(is_.gcount()));
+        is_->read(buffer_.data(), buffer_length_);
+        buffer_.resize(static_cast<size_t>(is_->gcount()));
         if (buffer_.size() == 0)
         {
             eof_ = true;
@@ -268,9 +306,9 @@ public:
         {
             if (parser_.source_exhausted())
             {
-                if (!is_.eof())
+                if (is_ != nullptr && !is_->eof())
                 {
-                    if (is_.fail())
+                    if (is_->fail())
                     {
                         ec = json_parser_errc::source_error;
                         return;
@@ -329,9 +367,9 @@ public:
             {
                 if (parser_.source_exhausted())
                 {
-                    if (!is_.eof())
+                    if (is_ != nullptr && !is_->eof())
                     {
-                        if (is_.fail())
+                        if (is_->fail())
                         {
                             ec = json_parser_errc::source_error;
                             return;
@@ -397,6 +435,18 @@ public:
 #endif
 
 private:
+
+    void set_string_source(const string_view_type& s)
+    {
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            throw parse_error(result.ec,1,1);
+        }
+        size_t offset = result.it - s.begin();
+        parser_.set_source(s.data()+offset,s.size()-offset);
+        begin_ = false;
+    }
 };
 
 typedef basic_json_reader<char> json_reader;
@@ -0,0 +1,104 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_RECLAIMER_HPP
+#define JSONCONS_JSON_RECLAIMER_HPP
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/json.hpp>
+
+namespace jsoncons {
+
+// basic_json_reclaimer
+
+// Destroys json values on a thread of its own. A caller done with a large document hands it
+// over with reclaim(), which only moves it, and goes on without waiting for it to be freed.
+// Values are destroyed on the reclaimer's thread, so their allocator must be safe to use from
+// there, which rules out, for example, an unsynchronized pool shared with the caller.
+
+template <class Json>
+class basic_json_reclaimer
+{
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    std::vector<Json> pending_;
+    size_t in_progress_;
+    bool stopping_;
+    std::thread thread_;
+public:
+    basic_json_reclaimer()
+        : in_progress_(0), stopping_(false)
+    {
+        thread_ = std::thread(&basic_json_reclaimer::run, this);
+    }
+
+    // Destroys what has been handed over and not yet destroyed before returning
+    ~basic_json_reclaimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_one();
+        thread_.join();
+    }
+
+    basic_json_reclaimer(const basic_json_reclaimer&) = delete;
+    basic_json_reclaimer& operator=(const basic_json_reclaimer&) = delete;
+
+    // Takes val, leaving it null, to be destroyed later on the reclaimer's thread
+    void reclaim(Json&& val)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(std::move(val));
+        }
+        work_ready_.notify_one();
+    }
+
+    // Waits until every value handed over so far has been destroyed
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_done_.wait(lock, [this]{return pending_.empty() && in_progress_ == 0;});
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            work_ready_.wait(lock, [this]{return stopping_ || !pending_.empty();});
+            if (pending_.empty())
+            {
+                break;
+            }
+            std::vector<Json> batch;
+            batch.swap(pending_);
+            in_progress_ = batch.size();
+            lock.unlock();
+            batch.clear();
+            lock.lock();
+            in_progress_ = 0;
+            work_done_.notify_all();
+        }
+    }
+};
+
+typedef basic_json_reclaimer<json> json_reclaimer;
+typedef basic_json_reclaimer<wjson> wjson_reclaimer;
+typedef basic_json_reclaimer<ojson> ojson_reclaimer;
+typedef basic_json_reclaimer<wojson> wojson_reclaimer;
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <jsoncons/json_output_handler.hpp>
 #include <jsoncons/detail/writers.hpp>
 #include <jsoncons/detail/number_printers.hpp>
+#include <jsoncons/detail/scanners.hpp>
 
 namespace jsoncons {
 
@@ -141,6 +142,18 @@ private:
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            // Write the run of characters that need no escaping in one go
+            const CharT* run_end = detail::find_escape_special(it, end, options.escape_solidus(), options.escape_all_non_ascii());
+            if (run_end != it)
+            {
+                writer.write(it, run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
+
             CharT c = *it;
             switch (c)
             {
@@ -19,12 +19,72 @@
 #include <iomanip>
 #include <utility>
 #include <initializer_list>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/jsoncons_utilities.hpp>
 #include <jsoncons/json_type_traits.hpp>
 
 namespace jsoncons {
 
+// policy_constants
+
+// The tuning constants of an implementation policy. A policy that leaves one out, as a policy
+// written before it was added does, gets the default that sorted_policy declares.
+
+namespace detail {
+
+template <class Policy, class Enable=void>
+struct object_hash_index_threshold_of
+{
+    static const size_t value = 32;
+};
+
+template <class Policy>
+struct object_hash_index_threshold_of<Policy,typename std::enable_if<std::is_integral<decltype(Policy::object_hash_index_threshold)>::value>::type>
+{
+    static const size_t value = Policy::object_hash_index_threshold;
+};
+
+template <class Policy, class Enable=void>
+struct object_key_prefix_threshold_of
+{
+    static const size_t value = 64;
+};
+
+template <class Policy>
+struct object_key_prefix_threshold_of<Policy,typename std::enable_if<std::is_integral<decltype(Policy::object_key_prefix_threshold)>::value>::type>
+{
+    static const size_t value = Policy::object_key_prefix_threshold;
+};
+
+template <class Policy, class Enable=void>
+struct object_append_buffer_threshold_of
+{
+    static const size_t value = 0;
+};
+
+template <class Policy>
+struct object_append_buffer_threshold_of<Policy,typename std::enable_if<std::is_integral<decltype(Policy::object_append_buffer_threshold)>::value>::type>
+{
+    static const size_t value = Policy::object_append_buffer_threshold;
+};
+
+template <class Policy, class Enable=void>
+struct packed_array_threshold_of
+{
+    static const size_t value = 0;
+};
+
+template <class Policy>
+struct packed_array_threshold_of<Policy,typename std::enable_if<std::is_integral<decltype(Policy::packed_array_threshold)>::value>::type>
+{
+    static const size_t value = Policy::packed_array_threshold;
+};
+
+}
+
 // json_array
 
 template <class Json>
@@ -51,10 +111,170 @@ public:
     allocator_type self_allocator_;
 };
 
+// packed_kind
+
+// The kind of numbers a json_array holds in packed storage
+enum class packed_kind : uint8_t
+{
+    none = 0,
+    integer,
+    uinteger,
+    floating
+};
+
+namespace detail {
+
+// Integers are stored in words as their two's complement bits
+template <class Allocator>
+struct packed_numbers
+{
+    typedef Allocator allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t> word_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<double> double_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t> precision_allocator_type;
+
+    packed_kind kind;
+    std::vector<uint64_t,word_allocator_type> words;
+    std::vector<double,double_allocator_type> doubles;
+    std::vector<uint8_t,precision_allocator_type> precisions;
+
+    packed_numbers(packed_kind k, const allocator_type& allocator)
+        : kind(k), 
+          words(word_allocator_type(allocator)), 
+          doubles(double_allocator_type(allocator)), 
+          precisions(precision_allocator_type(allocator))
+    {
+    }
+
+    packed_numbers(const packed_numbers& val, const allocator_type& allocator)
+        : kind(val.kind), 
+          words(val.words, word_allocator_type(allocator)), 
+          doubles(val.doubles, double_allocator_type(allocator)), 
+          precisions(val.precisions, precision_allocator_type(allocator))
+    {
+    }
+
+    size_t size() const
+    {
+        return kind == packed_kind::floating ? doubles.size() : words.size();
+    }
+
+    size_t capacity() const
+    {
+        return kind == packed_kind::floating ? doubles.capacity() : words.capacity();
+    }
+
+    void reserve(size_t n)
+    {
+        if (kind == packed_kind::floating)
+        {
+            doubles.reserve(n);
+        }
+        else
+        {
+            words.reserve(n);
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        words.shrink_to_fit();
+        doubles.shrink_to_fit();
+        precisions.shrink_to_fit();
+    }
+};
+
+}
+
+// Json_array_packed_
+
+// The packed values of a json_array, and whether they have been expanded into elements. Only
+// arrays of a policy with a packed_array_threshold pay for these, for others the base is empty,
+// packed() is always null, and the checks on it compile away.
+
+template <class Json, bool Packable = detail::packed_array_threshold_of<typename Json::implementation_policy>::value != 0>
+class Json_array_packed_
+{
+public:
+    typedef typename Json::allocator_type allocator_type;
+    typedef detail::packed_numbers<allocator_type> packed_numbers_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<packed_numbers_type> packed_allocator_type;
+    typedef typename std::allocator_traits<packed_allocator_type>::pointer packed_pointer_type;
+private:
+    // The packed values, or null. The elements are empty while expanded_ is false.
+    packed_pointer_type packed_;
+    mutable std::atomic<bool> expanded_;
+protected:
+    Json_array_packed_()
+        : packed_(nullptr), expanded_(true)
+    {
+    }
+
+    packed_pointer_type packed() const
+    {
+        return packed_;
+    }
+
+    void set_packed(packed_pointer_type p)
+    {
+        packed_ = p;
+    }
+
+    bool expanded(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return expanded_.load(order);
+    }
+
+    void set_expanded(bool value, std::memory_order order = std::memory_order_seq_cst) const
+    {
+        expanded_.store(value, order);
+    }
+
+    void swap_packed(Json_array_packed_& val)
+    {
+        std::swap(packed_, val.packed_);
+        bool expanded = expanded_;
+        expanded_ = val.expanded_.load();
+        val.expanded_ = expanded;
+    }
+};
+
+template <class Json>
+class Json_array_packed_<Json,false>
+{
+public:
+    typedef typename Json::allocator_type allocator_type;
+    typedef detail::packed_numbers<allocator_type> packed_numbers_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<packed_numbers_type> packed_allocator_type;
+    typedef typename std::allocator_traits<packed_allocator_type>::pointer packed_pointer_type;
+protected:
+    packed_pointer_type packed() const
+    {
+        return nullptr;
+    }
+
+    void set_packed(packed_pointer_type)
+    {
+    }
+
+    bool expanded(std::memory_order = std::memory_order_seq_cst) const
+    {
+        return true;
+    }
+
+    void set_expanded(bool, std::memory_order = std::memory_order_seq_cst) const
+    {
+    }
+
+    void swap_packed(Json_array_packed_&)
+    {
+    }
+};
+
 // json_array
 
 template <class Json>
-class json_array: public Json_array_base_<Json>
+class json_array: public Json_array_base_<Json>, public Json_array_packed_<Json>
 {
 public:
     typedef typename Json::allocator_type allocator_type;
@@ -106,24 +326,40 @@ public:
     }
     json_array(const json_array& val)
         : Json_array_base_<Json>(val.get_allocator()),
-          elements_(val.elements_)
+          elements_(val.packed() == nullptr ? val.elements_ : array_storage_type(val_allocator_type(val.get_allocator())))
     {
+        if (val.packed() != nullptr)
+        {
+            this->set_packed(create_packed(*val.packed()));
+            this->set_expanded(false);
+        }
     }
     json_array(const json_array& val, const allocator_type& allocator)
         : Json_array_base_<Json>(allocator), 
-          elements_(val.elements_,val_allocator_type(allocator))
+          elements_(val.packed() == nullptr ? val.elements_ : array_storage_type(),val_allocator_type(allocator))
     {
+        if (val.packed() != nullptr)
+        {
+            this->set_packed(create_packed(*val.packed()));
+            this->set_expanded(false);
+        }
     }
 
     json_array(json_array&& val) JSONCONS_NOEXCEPT
         : Json_array_base_<Json>(val.get_allocator()), 
           elements_(std::move(val.elements_))
     {
+        this->swap_packed(val);
     }
     json_array(json_array&& val, const allocator_type& allocator)
         : Json_array_base_<Json>(allocator), 
           elements_(std::move(val.elements_),val_allocator_type(allocator))
     {
+        if (val.packed() != nullptr)
+        {
+            this->set_packed(create_packed(*val.packed()));
+            this->set_expanded(val.expanded());
+        }
     }
 
     json_array(std::initializer_list<Json> init)
@@ -140,21 +376,33 @@ public:
     }
     ~json_array()
     {
+        destroy_packed();
     }
 
     void swap(json_array<Json>& val)
     {
         elements_.swap(val.elements_);
+        this->swap_packed(val);
     }
 
-    size_t size() const {return elements_.size();}
+    size_t size() const {return this->packed() != nullptr ? this->packed()->size() : elements_.size();}
 
-    size_t capacity() const {return elements_.capacity();}
+    size_t capacity() const {return this->packed() != nullptr && !this->expanded() ? this->packed()->capacity() : elements_.capacity();}
 
-    void clear() {elements_.clear();}
+    void clear() 
+    {
+        destroy_packed();
+        elements_.clear();
+    }
 
     void shrink_to_fit() 
     {
+        if (this->packed() != nullptr && !this->expanded())
+        {
+            this->packed()->shrink_to_fit();
+            return;
+        }
+        unpack();
         for (size_t i = 0; i < elements_.size(); ++i)
         {
             elements_[i].shrink_to_fit();
@@ -162,14 +410,32 @@ public:
         elements_.shrink_to_fit();
     }
 
-    void reserve(size_t n) {elements_.reserve(n);}
+    void reserve(size_t n) 
+    {
+        if (this->packed() != nullptr && !this->expanded())
+        {
+            this->packed()->reserve(n);
+            return;
+        }
+        unpack();
+        elements_.reserve(n);
+    }
 
-    void resize(size_t n) {elements_.resize(n);}
+    void resize(size_t n) 
+    {
+        unpack();
+        elements_.resize(n);
+    }
 
-    void resize(size_t n, const Json& val) {elements_.resize(n,val);}
+    void resize(size_t n, const Json& val) 
+    {
+        unpack();
+        elements_.resize(n,val);
+    }
 
     void remove_range(size_t from_index, size_t to_index) 
     {
+        unpack();
         JSONCONS_ASSERT(from_index <= to_index);
         JSONCONS_ASSERT(to_index <= elements_.size());
         elements_.erase(elements_.begin()+from_index,elements_.begin()+to_index);
@@ -177,17 +443,27 @@ public:
 
     void erase(const_iterator pos) 
     {
+        unpack();
         elements_.erase(pos);
     }
 
     void erase(const_iterator first, const_iterator last) 
     {
+        unpack();
         elements_.erase(first,last);
     }
 
-    Json& operator[](size_t i) {return elements_[i];}
+    Json& operator[](size_t i) 
+    {
+        unpack();
+        return elements_[i];
+    }
 
-    const Json& operator[](size_t i) const {return elements_[i];}
+    const Json& operator[](size_t i) const 
+    {
+        expand();
+        return elements_[i];
+    }
 
     // push_back
 
@@ -195,6 +471,11 @@ public:
     typename std::enable_if<is_stateless<A>::value,void>::type 
     push_back(T&& value)
     {
+        if (this->packed() != nullptr)
+        {
+            push_back_packed(Json(std::forward<T>(value)));
+            return;
+        }
         elements_.emplace_back(std::forward<T>(value));
     }
 
@@ -202,6 +483,11 @@ public:
     typename std::enable_if<!is_stateless<A>::value,void>::type 
     push_back(T&& value)
     {
+        if (this->packed() != nullptr)
+        {
+            push_back_packed(Json(std::forward<T>(value),get_allocator()));
+            return;
+        }
         elements_.emplace_back(std::forward<T>(value),get_allocator());
     }
 
@@ -209,6 +495,7 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type 
     insert(const_iterator pos, T&& value)
     {
+        unpack();
 #if defined(__GNUC__) && __GNUC__ == 4 && __GNUC_MINOR__ < 9
     // work around https://gcc.gnu.org/bugzilla/show_bug.cgi?id=54577
         iterator it = elements_.begin() + (pos - elements_.begin());
@@ -221,6 +508,7 @@ public:
     typename std::enable_if<!is_stateless<A>::value,iterator>::type 
     insert(const_iterator pos, T&& value)
     {
+        unpack();
 #if defined(__GNUC__) && __GNUC__ == 4 && __GNUC_MINOR__ < 9
     // work around https://gcc.gnu.org/bugzilla/show_bug.cgi?id=54577
         iterator it = elements_.begin() + (pos - elements_.begin());
@@ -233,6 +521,7 @@ public:
     template <class InputIt>
     iterator insert(const_iterator pos, InputIt first, InputIt last)
     {
+        unpack();
 #if defined(__GNUC__) && __GNUC__ == 4 && __GNUC_MINOR__ < 9
     // work around https://gcc.gnu.org/bugzilla/show_bug.cgi?id=54577
         iterator it = elements_.begin() + (pos - elements_.begin());
@@ -248,6 +537,7 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type 
     emplace(const_iterator pos, Args&&... args)
     {
+        unpack();
         iterator it = elements_.begin() + (pos - elements_.begin());
         return elements_.emplace(it, std::forward<Args>(args)...);
     }
@@ -256,23 +546,159 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type 
     emplace(const_iterator pos, Args&&... args)
     {
+        unpack();
         return elements_.emplace(pos, std::forward<Args>(args)...);
     }
 #endif
     template <class... Args>
     Json& emplace_back(Args&&... args)
     {
+        unpack();
         elements_.emplace_back(std::forward<Args>(args)...);
         return elements_.back();
     }
 
-    iterator begin() {return elements_.begin();}
+    iterator begin() 
+    {
+        unpack();
+        return elements_.begin();
+    }
 
-    iterator end() {return elements_.end();}
+    iterator end() 
+    {
+        unpack();
+        return elements_.end();
+    }
+
+    const_iterator begin() const 
+    {
+        expand();
+        return elements_.begin();
+    }
+
+    const_iterator end() const 
+    {
+        expand();
+        return elements_.end();
+    }
 
-    const_iterator begin() const {return elements_.begin();}
+    // Packed storage
 
-    const_iterator end() const {return elements_.end();}
+    // An array of integers, unsigned integers or doubles may hold them packed, contiguously
+    // and without a json value each. Access through iterators or operator[] expands it, once,
+    // into ordinary elements, and any change that a packed array cannot hold, such as inserting
+    // a value of another kind, leaves it unpacked. The packed_array_threshold of the
+    // implementation policy is the least number of values worth packing, and zero turns
+    // packing off.
+
+    packed_kind packing() const
+    {
+        return this->packed() != nullptr ? this->packed()->kind : packed_kind::none;
+    }
+
+    // The packed values, if the array is packed and T is int64_t, uint64_t or double to
+    // match its packing(), and null otherwise
+    template <class T>
+    const T* packed_data() const
+    {
+        return packing() != packed_kind::none && packing() == kind_of<T>() ? packed_pointer(static_cast<const T*>(nullptr)) : nullptr;
+    }
+
+    // The precisions the packed doubles were read with, or null if they are all 0
+    const uint8_t* packed_precisions() const
+    {
+        return this->packed() != nullptr && !this->packed()->precisions.empty() ? this->packed()->precisions.data() : nullptr;
+    }
+
+    // Packs the elements if there are enough of them and they are all integers, all unsigned
+    // integers or all doubles. Returns true if the array is packed.
+    bool pack()
+    {
+        if (this->packed() != nullptr)
+        {
+            return true;
+        }
+        val_allocator_type allocator(get_allocator());
+        array_storage_type elements(allocator);
+        elements.swap(elements_);
+        if (pack(elements.begin(), elements.end(), [](const Json& val) -> const Json& {return val;}))
+        {
+            return true;
+        }
+        elements.swap(elements_);
+        return false;
+    }
+
+    // Packs the values project(*it) for it in [first,last) into an empty array, as pack() would,
+    // without making elements of them first. Returns false, and leaves the array empty, if they
+    // cannot be packed.
+    template <class Iterator, class Projection>
+    bool pack(Iterator first, Iterator last, Projection project)
+    {
+        const size_t threshold = detail::packed_array_threshold_of<typename Json::implementation_policy>::value;
+        const size_t n = static_cast<size_t>(std::distance(first, last));
+        if (threshold == 0 || n < threshold || size() != 0)
+        {
+            return false;
+        }
+        const packed_kind kind = kind_of(project(*first));
+        if (kind == packed_kind::none)
+        {
+            return false;
+        }
+        bool has_precision = false;
+        for (auto it = first; it != last; ++it)
+        {
+            const Json& val = project(*it);
+            if (kind_of(val) != kind)
+            {
+                return false;
+            }
+            if (kind == packed_kind::floating && val.precision() != 0)
+            {
+                has_precision = true;
+            }
+        }
+
+        packed_pointer_type packed = create_packed(kind);
+        this->set_packed(packed);
+        this->set_expanded(false);
+        packed->reserve(n);
+        if (has_precision)
+        {
+            packed->precisions.reserve(n);
+        }
+        for (auto it = first; it != last; ++it)
+        {
+            const Json& val = project(*it);
+            switch (kind)
+            {
+            case packed_kind::integer:
+                packed->words.push_back(static_cast<uint64_t>(val.as_integer()));
+                break;
+            case packed_kind::uinteger:
+                packed->words.push_back(val.as_uinteger());
+                break;
+            default:
+                packed->doubles.push_back(val.as_double());
+                if (has_precision)
+                {
+                    packed->precisions.push_back(static_cast<uint8_t>(val.precision()));
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    // Replaces the elements with the values in [first,last), packed if they are int64_t,
+    // uint64_t or double and there are enough of them. Returns true if the array is packed.
+    template <class InputIt>
+    bool assign_packed(InputIt first, InputIt last)
+    {
+        typedef typename std::iterator_traits<InputIt>::value_type number_type;
+        return assign_packed(first, last, std::integral_constant<bool,kind_of<number_type>() != packed_kind::none>());
+    }
 
     bool operator==(const json_array<Json>& rhs) const
     {
@@ -280,6 +706,14 @@ public:
         {
             return false;
         }
+        if (packing() != packed_kind::none && packing() == rhs.packing())
+        {
+            return packing() == packed_kind::floating 
+                ? std::equal(this->packed()->doubles.begin(), this->packed()->doubles.end(), rhs.packed()->doubles.begin())
+                : std::equal(this->packed()->words.begin(), this->packed()->words.end(), rhs.packed()->words.begin());
+        }
+        expand();
+        rhs.expand();
         for (size_t i = 0; i < size(); ++i)
         {
             if (elements_[i] != rhs.elements_[i])
@@ -290,9 +724,218 @@ public:
         return true;
     }
 private:
+    typedef typename Json_array_packed_<Json>::packed_allocator_type packed_allocator_type;
+    typedef typename Json_array_packed_<Json>::packed_pointer_type packed_pointer_type;
+
     array_storage_type elements_;
 
     json_array& operator=(const json_array<Json>&) = delete;
+
+    template <class T>
+    static constexpr packed_kind kind_of()
+    {
+        return std::is_same<T,int64_t>::value ? packed_kind::integer 
+             : std::is_same<T,uint64_t>::value ? packed_kind::uinteger 
+             : std::is_same<T,double>::value ? packed_kind::floating 
+             : packed_kind::none;
+    }
+
+    static packed_kind kind_of(const Json& val)
+    {
+        // json_type_tag is declared with basic_json, after this header
+        typedef decltype(val.type_id()) type_tag;
+        switch (val.type_id())
+        {
+        case type_tag::integer_t:
+            return packed_kind::integer;
+        case type_tag::uinteger_t:
+            return packed_kind::uinteger;
+        case type_tag::double_t:
+            return packed_kind::floating;
+        default:
+            return packed_kind::none;
+        }
+    }
+
+    const int64_t* packed_pointer(const int64_t*) const
+    {
+        // int64_t may alias the uint64_t it was stored as
+        return reinterpret_cast<const int64_t*>(this->packed()->words.data());
+    }
+
+    const uint64_t* packed_pointer(const uint64_t*) const
+    {
+        return this->packed()->words.data();
+    }
+
+    const double* packed_pointer(const double*) const
+    {
+        return this->packed()->doubles.data();
+    }
+
+    template <class T>
+    const T* packed_pointer(const T*) const
+    {
+        return nullptr;
+    }
+
+    template <typename... Args>
+    packed_pointer_type create_packed(Args&& ... args)
+    {
+        packed_allocator_type alloc(get_allocator());
+        packed_pointer_type p = alloc.allocate(1);
+        try
+        {
+            std::allocator_traits<packed_allocator_type>::construct(alloc, detail::to_plain_pointer(p), std::forward<Args>(args)..., get_allocator());
+        }
+        catch (...)
+        {
+            alloc.deallocate(p,1);
+            throw;
+        }
+        return p;
+    }
+
+    void destroy_packed()
+    {
+        packed_pointer_type packed = this->packed();
+        if (packed != nullptr)
+        {
+            packed_allocator_type alloc(get_allocator());
+            std::allocator_traits<packed_allocator_type>::destroy(alloc, detail::to_plain_pointer(packed));
+            alloc.deallocate(packed,1);
+            this->set_packed(nullptr);
+        }
+        this->set_expanded(true);
+    }
+
+    template <class InputIt>
+    bool assign_packed(InputIt first, InputIt last, std::true_type)
+    {
+        typedef typename std::iterator_traits<InputIt>::value_type number_type;
+        const size_t threshold = detail::packed_array_threshold_of<typename Json::implementation_policy>::value;
+        const size_t n = static_cast<size_t>(std::distance(first, last));
+        if (threshold == 0 || n < threshold)
+        {
+            return assign_packed(first, last, std::false_type());
+        }
+        destroy_packed();
+        array_storage_type(val_allocator_type(get_allocator())).swap(elements_);
+        packed_pointer_type packed = create_packed(kind_of<number_type>());
+        this->set_packed(packed);
+        this->set_expanded(false);
+        if (kind_of<number_type>() == packed_kind::floating)
+        {
+            packed->doubles.assign(first, last);
+        }
+        else
+        {
+            packed->words.assign(first, last);
+        }
+        return true;
+    }
+
+    template <class InputIt>
+    bool assign_packed(InputIt first, InputIt last, std::false_type)
+    {
+        destroy_packed();
+        elements_.clear();
+        elements_.reserve(static_cast<size_t>(std::distance(first, last)));
+        for (auto it = first; it != last; ++it)
+        {
+            push_back(*it);
+        }
+        return false;
+    }
+
+    void push_back_packed(Json&& value)
+    {
+        if (!this->expanded() && kind_of(value) == this->packed()->kind)
+        {
+            switch (this->packed()->kind)
+            {
+            case packed_kind::integer:
+                this->packed()->words.push_back(static_cast<uint64_t>(value.as_integer()));
+                return;
+            case packed_kind::uinteger:
+                this->packed()->words.push_back(value.as_uinteger());
+                return;
+            default:
+                if (value.precision() != 0 && this->packed()->precisions.empty())
+                {
+                    this->packed()->precisions.resize(this->packed()->doubles.size());
+                }
+                this->packed()->doubles.push_back(value.as_double());
+                if (!this->packed()->precisions.empty())
+                {
+                    this->packed()->precisions.push_back(static_cast<uint8_t>(value.precision()));
+                }
+                return;
+            }
+        }
+        unpack();
+        elements_.emplace_back(std::move(value));
+    }
+
+    static std::mutex& expand_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Fills elements_ from the packed values. Reads call this even on a const array, so
+    // it is done at most once, under a lock, and leaves the packed values in place for
+    // readers that use them.
+    void expand() const
+    {
+        if (!this->expanded(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(expand_mutex());
+            if (!this->expanded(std::memory_order_relaxed))
+            {
+                const_cast<json_array*>(this)->expand_packed();
+            }
+        }
+    }
+
+    void expand_packed()
+    {
+        const size_t n = this->packed()->size();
+        elements_.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            switch (this->packed()->kind)
+            {
+            case packed_kind::integer:
+                elements_.emplace_back(static_cast<int64_t>(this->packed()->words[i]));
+                break;
+            case packed_kind::uinteger:
+                elements_.emplace_back(this->packed()->words[i]);
+                break;
+            default:
+                if (this->packed()->precisions.empty())
+                {
+                    elements_.emplace_back(this->packed()->doubles[i]);
+                }
+                else
+                {
+                    elements_.emplace_back(this->packed()->doubles[i], number_format(this->packed()->precisions[i], this->packed()->precisions[i]));
+                }
+                break;
+            }
+        }
+        this->set_expanded(true, std::memory_order_release);
+    }
+
+    // Expands the array and drops the packed values, before a change they cannot follow
+    void unpack()
+    {
+        if (this->packed() != nullptr)
+        {
+            expand();
+            destroy_packed();
+        }
+    }
 };
 
 // json_object
@@ -406,7 +1049,7 @@ public:
     {
     }
 
-    key_value_pair(key_value_pair&& member)
+    key_value_pair(key_value_pair&& member) JSONCONS_NOEXCEPT
         : key_(std::move(member.key_)), value_(std::move(member.value_))
     {
     }
@@ -536,6 +1179,162 @@ public:
     {
         return this->self_allocator_;
     }
+
+    // The members as stored, without the merge that begin() and end() may do first, so not
+    // necessarily in order. Safe to use where nothing may allocate, such as in destructors.
+    object_storage_type& storage() JSONCONS_NOEXCEPT
+    {
+        return members_;
+    }
+};
+
+// indirect_vector
+
+namespace detail {
+
+// A vector held through a single pointer and allocated only when it is first needed, for the
+// lookup structures of large objects, so that small objects pay one null pointer for them.
+// It does not keep the allocator: the owner passes its own to the calls that allocate or
+// free, and calls clear before it is destroyed.
+
+template <class T,class Allocator>
+class indirect_vector
+{
+public:
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<T> element_allocator_type;
+    typedef std::vector<T,element_allocator_type> vector_type;
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<vector_type> vector_allocator_type;
+    typedef typename std::allocator_traits<vector_allocator_type>::pointer pointer;
+private:
+    pointer ptr_;
+public:
+    indirect_vector()
+        : ptr_(nullptr)
+    {
+    }
+
+    indirect_vector(const indirect_vector& val, const Allocator& allocator)
+        : ptr_(nullptr)
+    {
+        if (val.ptr_ != nullptr)
+        {
+            create(allocator, *val.ptr_);
+        }
+    }
+
+    indirect_vector(indirect_vector&& val) JSONCONS_NOEXCEPT
+        : ptr_(val.ptr_)
+    {
+        val.ptr_ = nullptr;
+    }
+
+    indirect_vector& operator=(const indirect_vector&) = delete;
+
+    bool empty() const
+    {
+        return ptr_ == nullptr || ptr_->empty();
+    }
+
+    const vector_type& operator*() const
+    {
+        return *ptr_;
+    }
+
+    vector_type& operator*()
+    {
+        return *ptr_;
+    }
+
+    // The vector, allocated empty if there is none
+
+    vector_type& get(const Allocator& allocator)
+    {
+        if (ptr_ == nullptr)
+        {
+            create(allocator);
+        }
+        return *ptr_;
+    }
+
+    void clear(const Allocator& allocator)
+    {
+        if (ptr_ != nullptr)
+        {
+            vector_allocator_type alloc(allocator);
+            std::allocator_traits<vector_allocator_type>::destroy(alloc, detail::to_plain_pointer(ptr_));
+            alloc.deallocate(ptr_,1);
+            ptr_ = nullptr;
+        }
+    }
+
+    void swap(indirect_vector& val) JSONCONS_NOEXCEPT
+    {
+        std::swap(ptr_,val.ptr_);
+    }
+private:
+    template <typename... Args>
+    void create(const Allocator& allocator, Args&& ... args)
+    {
+        vector_allocator_type alloc(allocator);
+        pointer p = alloc.allocate(1);
+        try
+        {
+            std::allocator_traits<vector_allocator_type>::construct(alloc, detail::to_plain_pointer(p), std::forward<Args>(args)..., element_allocator_type(allocator));
+        }
+        catch (...)
+        {
+            alloc.deallocate(p,1);
+            throw;
+        }
+        ptr_ = p;
+    }
+};
+
+}
+
+// Json_object_sorted_size_
+
+// How many of the members of a sorted object are sorted, members_[0,sorted_size_). Once an object
+// has object_append_buffer_threshold members, if that is not zero, insertions append the members
+// after the sorted ones, unsorted, and these are merged in when there are too many of them, or
+// before the members are next looked up or iterated over. So with the buffer on, an iterator or
+// reference returned by an insertion is invalidated by the next lookup, const or not, as by the
+// next insertion. Without it, all members are sorted, the base is empty, and the merge compiles
+// away.
+
+template <class Json, bool Buffered = detail::object_append_buffer_threshold_of<typename Json::implementation_policy>::value != 0>
+class Json_object_sorted_size_
+{
+    std::atomic<size_t> sorted_size_;
+protected:
+    Json_object_sorted_size_()
+        : sorted_size_(0)
+    {
+    }
+
+    size_t sorted_size_of(size_t, std::memory_order order = std::memory_order_relaxed) const
+    {
+        return sorted_size_.load(order);
+    }
+
+    void set_sorted_size(size_t n, std::memory_order order = std::memory_order_seq_cst)
+    {
+        sorted_size_.store(n, order);
+    }
+};
+
+template <class Json>
+class Json_object_sorted_size_<Json,false>
+{
+protected:
+    size_t sorted_size_of(size_t size, std::memory_order = std::memory_order_relaxed) const
+    {
+        return size;
+    }
+
+    void set_sorted_size(size_t, std::memory_order = std::memory_order_seq_cst)
+    {
+    }
 };
 
 // json_object
@@ -547,7 +1346,7 @@ class json_object
 
 // Do not preserve order
 template <class KeyT,class Json>
-class json_object<KeyT,Json,false> : public Json_object_<KeyT,Json>
+class json_object<KeyT,Json,false> : public Json_object_<KeyT,Json>, public Json_object_sorted_size_<Json>
 {
 public:
     using typename Json_object_<KeyT,Json>::allocator_type;
@@ -561,6 +1360,12 @@ public:
     using typename Json_object_<KeyT,Json>::iterator;
     using typename Json_object_<KeyT,Json>::const_iterator;
     using Json_object_<KeyT,Json>::get_allocator;
+private:
+    // The leading characters of each key packed into an integer that orders the same way
+    // as the keys, kept while the object has at least object_key_prefix_threshold members.
+    // Lookups binary search this dense array, and compare whole keys only when prefixes tie.
+    detail::indirect_vector<uint64_t,allocator_type> prefixes_;
+public:
 
     json_object()
         : Json_object_<KeyT,Json>()
@@ -572,23 +1377,39 @@ public:
     }
 
     json_object(const json_object& val)
-        : Json_object_<KeyT,Json>(val)
+        : Json_object_<KeyT,Json>(merged(val)),
+          prefixes_(val.prefixes_, val.get_allocator())
     {
+        this->set_sorted_size(this->members_.size());
     }
 
     json_object(json_object&& val)
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val))
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val)),
+          prefixes_(std::move(val.prefixes_))
     {
+        this->set_sorted_size(val.sorted_size());
+        val.set_sorted_size(val.members_.size());
     }
 
     json_object(const json_object& val, const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(val,allocator)
+        : Json_object_<KeyT,Json>(merged(val),allocator),
+          prefixes_(val.prefixes_, allocator)
     {
+        this->set_sorted_size(this->members_.size());
     }
 
     json_object(json_object&& val,const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator)
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator),
+          prefixes_(val.prefixes_, allocator)
+    {
+        this->set_sorted_size(val.sorted_size());
+        val.set_sorted_size(val.members_.size());
+        val.prefixes_.clear(val.get_allocator());
+    }
+
+    ~json_object()
     {
+        prefixes_.clear(get_allocator());
     }
 
     json_object(std::initializer_list<std::pair<string_view_type,Json>> init)
@@ -615,25 +1436,33 @@ public:
     void swap(json_object& val)
     {
         Json_object_<KeyT,Json>::swap(val);
+        prefixes_.swap(val.prefixes_);
+        size_t n = sorted_size();
+        this->set_sorted_size(val.sorted_size());
+        val.set_sorted_size(n);
     }
 
     iterator begin()
     {
+        merge_appended();
         return this->members_.begin();
     }
 
     iterator end()
     {
+        merge_appended();
         return this->members_.end();
     }
 
     const_iterator begin() const
     {
+        merge_appended();
         return this->members_.begin();
     }
 
     const_iterator end() const
     {
+        merge_appended();
         return this->members_.end();
     }
 
@@ -641,7 +1470,12 @@ public:
 
     size_t capacity() const {return this->members_.capacity();}
 
-    void clear() {this->members_.clear();}
+    void clear()
+    {
+        this->members_.clear();
+        prefixes_.clear(get_allocator());
+        this->set_sorted_size(0);
+    }
 
     void shrink_to_fit() 
     {
@@ -660,6 +1494,7 @@ public:
         {
             JSONCONS_THROW_EXCEPTION_OLD(std::out_of_range,"Invalid array subscript");
         }
+        merge_appended();
         return this->members_[i].value();
     }
 
@@ -669,43 +1504,50 @@ public:
         {
             JSONCONS_THROW_EXCEPTION_OLD(std::out_of_range,"Invalid array subscript");
         }
+        merge_appended();
         return this->members_[i].value();
     }
 
     iterator find(const string_view_type& name)
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+        merge_appended();
+        auto it = this->members_.begin() + lower_bound_position(0, name);
         auto result = (it != this->members_.end() && it->key() == name) ? it : this->members_.end();
         return result;
     }
 
     const_iterator find(const string_view_type& name) const
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), 
-                                   name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});
+        merge_appended();
+        auto it = this->members_.begin() + lower_bound_position(0, name);
         auto result = (it != this->members_.end() && it->key() == name) ? it : this->members_.end();
         return result;
     }
 
     void erase(const_iterator pos) 
     {
-        this->members_.erase(pos);
+        erase_member(pos - this->members_.cbegin());
     }
 
     void erase(const_iterator first, const_iterator last) 
     {
+        size_t sorted = sorted_size();
+        size_t first_index = first - this->members_.cbegin();
+        size_t last_index = last - this->members_.cbegin();
         this->members_.erase(first,last);
+        if (first_index < sorted)
+        {
+            this->set_sorted_size(sorted - ((std::min)(last_index, sorted) - first_index));
+        }
+        build_prefixes();
     }
 
     void erase(const string_view_type& name) 
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it != this->members_.end() && it->key() == name)
+        auto pos = search(0, name);
+        if (pos.second)
         {
-            this->members_.erase(it);
+            erase_member(pos.first);
         }
     }
 
@@ -723,6 +1565,8 @@ public:
         auto it = std::unique(this->members_.rbegin(), this->members_.rend(),
                               [](const value_type& a, const value_type& b){ return !(a.key().compare(b.key()));});
         this->members_.erase(this->members_.begin(),it.base());
+        this->set_sorted_size(this->members_.size());
+        build_prefixes();
     }
 
     // merge
@@ -741,15 +1585,10 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::lower_bound(this->members_.begin(),this->members_.end(), it->key(), 
-                                        [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});   
-            if (pos == this->members_.end() )
+            auto pos = search(0, it->key());
+            if (!pos.second)
             {
-                this->members_.emplace_back(*it);
-            }
-            else if (it->key() != pos->key())
-            {
-                this->members_.emplace(pos,*it);
+                emplace_member(pos.first, it->key(), *it);
             }
         }
     }
@@ -768,25 +1607,10 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            iterator pos;
-            if (hint != this->members_.end() && hint->key() <= it->key())
-            {
-                pos = std::lower_bound(hint,this->members_.end(), it->key(), 
-                                      [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-            }
-            else
+            auto pos = search(hint_position(hint, it->key()), it->key());
+            if (!pos.second)
             {
-                pos = std::lower_bound(this->members_.begin(),this->members_.end(), it->key(), 
-                                      [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-            }
-            if (pos == this->members_.end() )
-            {
-                this->members_.emplace_back(*it);
-                hint = this->members_.begin() + (this->members_.size() - 1);
-            }
-            else if (it->key() != pos->key())
-            {
-                hint = this->members_.emplace(pos,*it);
+                hint = emplace_member(pos.first, it->key(), *it);
             }
         }
     }
@@ -807,15 +1631,14 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::lower_bound(this->members_.begin(),this->members_.end(), it->key(), 
-                                        [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});   
-            if (pos == this->members_.end() )
+            auto pos = search(0, it->key());
+            if (!pos.second)
             {
-                this->members_.emplace_back(*it);
+                emplace_member(pos.first, it->key(), *it);
             }
             else 
             {
-                pos->value(it->value());
+                this->members_[pos.first].value(it->value());
             }
         }
     }
@@ -834,26 +1657,15 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            iterator pos;
-            if (hint != this->members_.end() && hint->key() <= it->key())
+            auto pos = search(hint_position(hint, it->key()), it->key());
+            if (!pos.second)
             {
-                pos = std::lower_bound(hint,this->members_.end(), it->key(), 
-                                      [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+                hint = emplace_member(pos.first, it->key(), *it);
             }
             else
             {
-                pos = std::lower_bound(this->members_.begin(),this->members_.end(), it->key(), 
-                                      [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-            }
-            if (pos == this->members_.end() )
-            {
-                this->members_.emplace_back(*it);
-                hint = this->members_.begin() + (this->members_.size() - 1);
-            }
-            else 
-            {
-                pos->value(it->value());
-                hint = pos;
+                hint = this->members_.begin() + pos.first;
+                hint->value(it->value());
             }
         }
     }
@@ -865,25 +1677,19 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
-                                        std::forward<T>(value));
-            inserted = true;
-            it = this->members_.begin() + this->members_.size() - 1;
-        }
-        else if (it->key() == name)
+        iterator it;
+        auto pos = search(0, name);
+        if (pos.second)
         {
+            it = this->members_.begin() + pos.first;
             it->value(Json(std::forward<T>(value)));
             inserted = false; // assigned
         }
         else
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end()),
-                                        std::forward<T>(value));
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end()),
+                                std::forward<T>(value));
             inserted = true;
         }
         return std::make_pair(it,inserted);
@@ -894,25 +1700,19 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                        std::forward<T>(value),get_allocator());
-            inserted = true;
-            it = this->members_.begin() + this->members_.size() - 1;
-        }
-        else if (it->key() == name)
+        iterator it;
+        auto pos = search(0, name);
+        if (pos.second)
         {
+            it = this->members_.begin() + pos.first;
             it->value(Json(std::forward<T>(value), get_allocator()));
             inserted = false; // assigned
         }
         else
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end(), get_allocator()),
-                                        std::forward<T>(value),get_allocator());
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end(), get_allocator()),
+                                std::forward<T>(value),get_allocator());
             inserted = true;
         }
         return std::make_pair(it,inserted);
@@ -925,24 +1725,18 @@ public:
     try_emplace(const string_view_type& name, Args&&... args)
     {
         bool inserted;
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
-                                        std::forward<Args>(args)...);
-            it = this->members_.begin() + this->members_.size() - 1;
-            inserted = true;
-        }
-        else if (it->key() == name)
+        iterator it;
+        auto pos = search(0, name);
+        if (pos.second)
         {
+            it = this->members_.begin() + pos.first;
             inserted = false;
         }
         else
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end()),
-                                        std::forward<Args>(args)...);
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end()),
+                                std::forward<Args>(args)...);
             inserted = true;
         }
         return std::make_pair(it,inserted);
@@ -953,24 +1747,18 @@ public:
     try_emplace(const string_view_type& name, Args&&... args)
     {
         bool inserted;
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                        std::forward<Args>(args)...);
-            it = this->members_.begin() + this->members_.size() - 1;
-            inserted = true;
-        }
-        else if (it->key() == name)
+        iterator it;
+        auto pos = search(0, name);
+        if (pos.second)
         {
+            it = this->members_.begin() + pos.first;
             inserted = false;
         }
         else
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end(), get_allocator()),
-                                        std::forward<Args>(args)...);
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end(), get_allocator()),
+                                std::forward<Args>(args)...);
             inserted = true;
         }
         return std::make_pair(it,inserted);
@@ -980,68 +1768,28 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type 
     try_emplace(iterator hint, const string_view_type& name, Args&&... args)
     {
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
-        {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        }
-
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
-                                        std::forward<Args>(args)...);
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
-        {
-        }
-        else
-        {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end()),
-                                        std::forward<Args>(args)...);
+        auto pos = search(hint_position(hint, name), name);
+        if (pos.second)
+        {
+            return this->members_.begin() + pos.first;
         }
-        return it;
+        return emplace_member(pos.first, name,
+                              key_storage_type(name.begin(),name.end()),
+                              std::forward<Args>(args)...);
     }
 
     template <class A=allocator_type, class ... Args>
     typename std::enable_if<!is_stateless<A>::value,iterator>::type 
     try_emplace(iterator hint, const string_view_type& name, Args&&... args)
     {
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
-        {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        }
-
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                        std::forward<Args>(args)...);
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
-        {
-        }
-        else
+        auto pos = search(hint_position(hint, name), name);
+        if (pos.second)
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end(), get_allocator()),
-                                        std::forward<Args>(args)...);
+            return this->members_.begin() + pos.first;
         }
-        return it;
+        return emplace_member(pos.first, name,
+                              key_storage_type(name.begin(),name.end(), get_allocator()),
+                              std::forward<Args>(args)...);
     }
 
     // set_
@@ -1051,22 +1799,16 @@ public:
     set_(key_storage_type&& name, T&& value)
     {
         string_view_type s(name.data(), name.size());
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(std::forward<key_storage_type>(name), 
-                                  std::forward<T>(value));
-        }
-        else if (string_view_type(it->key().data(),it->key().length()) == s)
+        auto pos = search(0, s);
+        if (pos.second)
         {
-            it->value(Json(std::forward<T>(value)));
+            this->members_[pos.first].value(Json(std::forward<T>(value)));
         }
         else
         {
-            this->members_.emplace(it,
-                             std::forward<key_storage_type>(name),
-                             std::forward<T>(value));
+            emplace_member(pos.first, s,
+                           std::forward<key_storage_type>(name),
+                           std::forward<T>(value));
         }
     }
 
@@ -1075,22 +1817,16 @@ public:
     set_(key_storage_type&& name, T&& value)
     {
         string_view_type s(name.data(), name.size());
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s,
-                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(std::forward<key_storage_type>(name), 
-                                  std::forward<T>(value),get_allocator() );
-        }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        auto pos = search(0, s);
+        if (pos.second)
         {
-            it->value(Json(std::forward<T>(value),get_allocator() ));
+            this->members_[pos.first].value(Json(std::forward<T>(value),get_allocator() ));
         }
         else
         {
-            this->members_.emplace(it,
-                             std::forward<key_storage_type>(name),
-                             std::forward<T>(value),get_allocator() );
+            emplace_member(pos.first, s,
+                           std::forward<key_storage_type>(name),
+                           std::forward<T>(value),get_allocator() );
         }
     }
 
@@ -1099,163 +1835,335 @@ public:
     insert_or_assign(iterator hint, const string_view_type& name, T&& value)
     {
         iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
+        auto pos = search(hint_position(hint, name), name);
+        if (pos.second)
         {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            it = this->members_.begin() + pos.first;
+            it->value(Json(std::forward<T>(value)));
         }
         else
         {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end()),
+                                std::forward<T>(value));
         }
+        return it;
+    }
 
-        if (it == this->members_.end())
+    template <class T, class A=allocator_type>
+    typename std::enable_if<!is_stateless<A>::value,iterator>::type 
+    insert_or_assign(iterator hint, const string_view_type& name, T&& value)
+    {
+        iterator it;
+        auto pos = search(hint_position(hint, name), name);
+        if (pos.second)
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
-                                        std::forward<T>(value));
-            it = this->members_.begin() + (this->members_.size() - 1);
+            it = this->members_.begin() + pos.first;
+            it->value(Json(std::forward<T>(value),get_allocator()));
+        }
+        else
+        {
+            it = emplace_member(pos.first, name,
+                                key_storage_type(name.begin(),name.end(), get_allocator()),
+                                std::forward<T>(value),get_allocator());
         }
-        else if (it->key() == name)
+        return it;
+    }
+
+    template <class T, class A=allocator_type>
+    typename std::enable_if<is_stateless<A>::value,iterator>::type 
+    set_(iterator hint, key_storage_type&& name, T&& value)
+    {
+        string_view_type s(name.data(), name.size());
+        iterator it;
+        auto pos = search(hint_position(hint, s), s);
+        if (pos.second)
         {
+            it = this->members_.begin() + pos.first;
             it->value(Json(std::forward<T>(value)));
         }
         else
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end()),
-                                        std::forward<T>(value));
+            it = emplace_member(pos.first, s,
+                                std::forward<key_storage_type>(name),
+                                std::forward<T>(value));
         }
         return it;
     }
 
     template <class T, class A=allocator_type>
     typename std::enable_if<!is_stateless<A>::value,iterator>::type 
-    insert_or_assign(iterator hint, const string_view_type& name, T&& value)
+    set_(iterator hint, key_storage_type&& name, T&& value)
     {
+        string_view_type s(name.data(), name.size());
         iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
+        auto pos = search(hint_position(hint, s), s);
+        if (pos.second)
         {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            it = this->members_.begin() + pos.first;
+            it->value(Json(std::forward<T>(value),get_allocator() ));
         }
         else
         {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            it = emplace_member(pos.first, s,
+                                std::forward<key_storage_type>(name),
+                                std::forward<T>(value),get_allocator() );
         }
+        return it;
+    }
 
-        if (it == this->members_.end())
+    bool operator==(const json_object& rhs) const
+    {
+        if (size() != rhs.size())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                        std::forward<T>(value),get_allocator());
-            it = this->members_.begin() + (this->members_.size() - 1);
+            return false;
         }
-        else if (it->key() == name)
+        // Both are sorted by key with no duplicates
+        auto rhs_it = rhs.begin();
+        for (auto it = begin(); it != end(); ++it, ++rhs_it)
         {
-            it->value(Json(std::forward<T>(value),get_allocator()));
+            if (rhs_it->key() != it->key() || rhs_it->value() != it->value())
+            {
+                return false;
+            }
         }
-        else
+        return true;
+    }
+
+    bool has_key_prefixes() const
+    {
+        return !prefixes_.empty();
+    }
+
+    size_t appended_size() const
+    {
+        return this->members_.size() - sorted_size();
+    }
+private:
+    json_object& operator=(const json_object&) = delete;
+
+    size_t sorted_size() const
+    {
+        return this->sorted_size_of(this->members_.size());
+    }
+
+    static const json_object& merged(const json_object& val)
+    {
+        val.merge_appended();
+        return val;
+    }
+
+    static std::mutex& merge_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Sorts the appended members into the others. Lookups and iteration call this even on a
+    // const object, so that concurrent readers of an object see it sorted, and only one of
+    // them does the merge.
+
+    void merge_appended() const
+    {
+        if (this->sorted_size_of(this->members_.size(), std::memory_order_acquire) != this->members_.size())
         {
-            it = this->members_.emplace(it,
-                                        key_storage_type(name.begin(),name.end(), get_allocator()),
-                                        std::forward<T>(value),get_allocator());
+            std::lock_guard<std::mutex> lock(merge_mutex());
+            if (sorted_size() != this->members_.size())
+            {
+                const_cast<json_object*>(this)->merge_appended_members();
+            }
         }
-        return it;
     }
 
-    template <class T, class A=allocator_type>
-    typename std::enable_if<is_stateless<A>::value,iterator>::type 
-    set_(iterator hint, key_storage_type&& name, T&& value)
+    void merge_appended_members()
     {
-        string_view_type s(name.data(), name.size());
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= s)
+        auto middle = this->members_.begin() + sorted_size();
+        auto compare = [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;};
+        std::sort(middle, this->members_.end(), compare);
+        std::inplace_merge(this->members_.begin(), middle, this->members_.end(), compare);
+        build_prefixes(this->members_.size());
+        this->set_sorted_size(this->members_.size(), std::memory_order_release);
+    }
+
+    size_t append_limit() const
+    {
+        // About the square root of the size, so merges cost O(sqrt(n)) per insertion,
+        // as do the linear searches of the appended members
+        size_t limit = 16;
+        while (limit*limit < this->members_.size())
         {
-            it = std::lower_bound(hint,this->members_.end(), s, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            limit *= 2;
         }
-        else
+        return limit;
+    }
+
+    // Inserts a member named name, where pos is where it belongs among the sorted members
+
+    template <class... Args>
+    iterator emplace_member(size_t pos, const string_view_type& name, Args&&... args)
+    {
+        const size_t threshold = detail::object_append_buffer_threshold_of<typename Json::implementation_policy>::value;
+        if (pos < this->members_.size() && threshold != 0 && this->members_.size() >= threshold)
         {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            if (appended_size() < append_limit())
+            {
+                this->members_.emplace_back(std::forward<Args>(args)...);
+                return this->members_.begin() + (this->members_.size() - 1);
+            }
+            merge_appended_members();
+            pos = lower_bound_position(0, name);
         }
+        auto it = this->members_.emplace(this->members_.begin() + pos, std::forward<Args>(args)...);
+        this->set_sorted_size(sorted_size() + 1);
+        prefix_insert(pos);
+        return it;
+    }
 
-        if (it == this->members_.end())
+    void erase_member(size_t pos)
+    {
+        size_t sorted = sorted_size();
+        this->members_.erase(this->members_.begin() + pos);
+        if (pos < sorted)
         {
-            this->members_.emplace_back(std::forward<key_storage_type>(name), 
-                                  std::forward<T>(value));
-            it = this->members_.begin() + (this->members_.size() - 1);
+            this->set_sorted_size(sorted - 1);
+            prefix_erase(pos);
         }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
+    }
+
+    // Returns the position of the member named name and true, or where it belongs
+    // among the sorted members and false
+
+    std::pair<size_t,bool> search(size_t first, const string_view_type& name) const
+    {
+        size_t sorted = sorted_size();
+        size_t pos = lower_bound_position(first, name);
+        if (pos < sorted && this->members_[pos].key() == name)
         {
-            it->value(Json(std::forward<T>(value)));
+            return std::make_pair(pos,true);
         }
-        else
+        for (size_t i = sorted; i < this->members_.size(); ++i)
         {
-            it = this->members_.emplace(it,
-                                  std::forward<key_storage_type>(name),
-                                  std::forward<T>(value));
+            if (this->members_[i].key() == name)
+            {
+                return std::make_pair(i,true);
+            }
         }
-        return it;
+        return std::make_pair(pos,false);
     }
 
-    template <class T, class A=allocator_type>
-    typename std::enable_if<!is_stateless<A>::value,iterator>::type 
-    set_(iterator hint, key_storage_type&& name, T&& value)
+    size_t hint_position(iterator hint, const string_view_type& name) const
     {
-        string_view_type s(name.data(), name.size());
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= s)
+        size_t pos = hint - this->members_.begin();
+        return pos < sorted_size() && this->members_[pos].key() <= name ? pos : 0;
+    }
+
+    static uint64_t key_prefix(const string_view_type& s)
+    {
+        typedef typename std::make_unsigned<char_type>::type uchar_type;
+        const size_t char_bits = 8*sizeof(char_type);
+        const size_t length = 8/sizeof(char_type);
+
+        uint64_t prefix = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            uint64_t c = 0;
+            if (i < s.length())
+            {
+                c = static_cast<uchar_type>(s[i]);
+                // char_traits<char> compares characters as unsigned char, other character types as themselves
+                if (std::is_signed<char_type>::value && !std::is_same<char_type,char>::value)
+                {
+                    c ^= uint64_t(1) << (char_bits - 1);
+                }
+            }
+            prefix = (prefix << char_bits) | c;
+        }
+        return prefix;
+    }
+
+    // The first of the sorted members from first on whose key is not less than name
+
+    size_t lower_bound_position(size_t first, const string_view_type& name) const
+    {
+        size_t sorted = sorted_size();
+        if (prefixes_.empty())
         {
-            it = std::lower_bound(hint,this->members_.end(), s, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            auto it = std::lower_bound(this->members_.begin() + first,this->members_.begin() + sorted, name,
+                                       [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});
+            return it - this->members_.begin();
         }
-        else
+        // A key with a smaller prefix is less than name, and one with a larger prefix greater
+        const auto& prefixes = *prefixes_;
+        uint64_t prefix = key_prefix(name);
+        auto lo = std::lower_bound(prefixes.begin() + first, prefixes.end(), prefix);
+        if (lo == prefixes.end() || *lo != prefix)
         {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                  [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});        
+            return lo - prefixes.begin();
         }
+        auto hi = std::upper_bound(lo, prefixes.end(), prefix);
+        auto it = std::lower_bound(this->members_.begin() + (lo - prefixes.begin()),
+                                   this->members_.begin() + (hi - prefixes.begin()), name, 
+                                   [](const value_type& a, const string_view_type& k){return a.key().compare(k) < 0;});
+        return it - this->members_.begin();
+    }
 
-        if (it == this->members_.end())
+    // Rebuilds the prefixes of the sorted members, or frees them if there are fewer than the threshold
+
+    void build_prefixes()
+    {
+        build_prefixes(sorted_size());
+    }
+
+    void build_prefixes(size_t sorted)
+    {
+        const size_t threshold = detail::object_key_prefix_threshold_of<typename Json::implementation_policy>::value;
+        if (threshold == 0 || sorted < threshold)
         {
-            this->members_.emplace_back(std::forward<key_storage_type>(name), 
-                                  std::forward<T>(value),get_allocator() );
-            it = this->members_.begin() + (this->members_.size() - 1);
+            prefixes_.clear(get_allocator());
+            return;
         }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        auto& prefixes = prefixes_.get(get_allocator());
+        prefixes.resize(sorted);
+        for (size_t i = 0; i < sorted; ++i)
         {
-            it->value(Json(std::forward<T>(value),get_allocator() ));
+            prefixes[i] = key_prefix(this->members_[i].key());
+        }
+    }
+
+    // Records a member just inserted into the sorted members at pos
+
+    void prefix_insert(size_t pos)
+    {
+        if (prefixes_.empty())
+        {
+            build_prefixes();
         }
         else
         {
-            it = this->members_.emplace(it,
-                                  std::forward<key_storage_type>(name),
-                                  std::forward<T>(value),get_allocator() );
+            auto& prefixes = *prefixes_;
+            prefixes.insert(prefixes.begin() + pos, key_prefix(this->members_[pos].key()));
         }
-        return it;
     }
 
-    bool operator==(const json_object& rhs) const
+    // Records a member just erased from the sorted members at pos
+
+    void prefix_erase(size_t pos)
     {
-        if (size() != rhs.size())
+        if (prefixes_.empty())
         {
-            return false;
+            return;
         }
-        for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
+        const size_t threshold = detail::object_key_prefix_threshold_of<typename Json::implementation_policy>::value;
+        if (sorted_size() < threshold)
         {
-
-            auto rhs_it = std::lower_bound(rhs.begin(), rhs.end(), *it, 
-                                           [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;});
-            if (rhs_it == rhs.end() || rhs_it->key() != it->key() || rhs_it->value() != it->value())
-            {
-                return false;
-            }
+            prefixes_.clear(get_allocator());
+        }
+        else
+        {
+            auto& prefixes = *prefixes_;
+            prefixes.erase(prefixes.begin() + pos);
         }
-        return true;
     }
-private:
-    json_object& operator=(const json_object&) = delete;
 };
 
 // Preserve order
@@ -1274,6 +2182,12 @@ public:
     using typename Json_object_<KeyT,Json>::iterator;
     using typename Json_object_<KeyT,Json>::const_iterator;
     using Json_object_<KeyT,Json>::get_allocator;
+private:
+    // Open addressing hash index over members_, kept while the object has at least
+    // object_hash_index_threshold members. Each slot holds a member position plus one,
+    // zero marks an empty slot.
+    detail::indirect_vector<size_t,allocator_type> index_;
+public:
 
     json_object()
         : Json_object_<KeyT,Json>()
@@ -1285,23 +2199,33 @@ public:
     }
 
     json_object(const json_object& val)
-        : Json_object_<KeyT,Json>(val)
+        : Json_object_<KeyT,Json>(val),
+          index_(val.index_, val.get_allocator())
     {
     }
 
     json_object(json_object&& val)
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val))
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val)),
+          index_(std::move(val.index_))
     {
     }
 
     json_object(const json_object& val, const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(val,allocator)
+        : Json_object_<KeyT,Json>(val,allocator),
+          index_(val.index_, allocator)
     {
     }
 
     json_object(json_object&& val,const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator)
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator),
+          index_(val.index_, allocator)
+    {
+        val.index_.clear(val.get_allocator());
+    }
+
+    ~json_object()
     {
+        index_.clear(get_allocator());
     }
 
     json_object(std::initializer_list<typename Json::array> init)
@@ -1342,6 +2266,7 @@ public:
     void swap(json_object& val)
     {
         Json_object_<KeyT,Json>::swap(val);
+        index_.swap(val.index_);
     }
 
     iterator begin()
@@ -1368,7 +2293,11 @@ public:
 
     size_t capacity() const {return this->members_.capacity();}
 
-    void clear() {this->members_.clear();}
+    void clear()
+    {
+        this->members_.clear();
+        index_.clear(get_allocator());
+    }
 
     void shrink_to_fit() 
     {
@@ -1401,28 +2330,27 @@ public:
 
     iterator find(const string_view_type& name)
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kv){return kv.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     const_iterator find(const string_view_type& name) const
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kv){return kv.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     void erase(const_iterator first, const_iterator last) 
     {
         this->members_.erase(first,last);
+        build_index();
     }
 
     void erase(const string_view_type& name) 
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [name](const value_type& kv){return kv.key() == name;});
-        if (it != this->members_.end())
+        size_t pos = find_position(name);
+        if (pos < this->members_.size())
         {
-            this->members_.erase(it);
+            index_erase(pos);
+            this->members_.erase(this->members_.begin() + pos);
         }
     }
 
@@ -1438,6 +2366,7 @@ public:
         auto it = last_wins_unique_sequence(this->members_.begin(), this->members_.end(),
                               [](const value_type& a, const value_type& b){ return a.key().compare(b.key());});
         this->members_.erase(it,this->members_.end());
+        build_index();
     }
 
     // insert_or_assign
@@ -1447,13 +2376,13 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
+        auto it = find(name);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
                                         std::forward<T>(value));
+            index_insert(this->members_.size() - 1);
             it = this->members_.begin() + this->members_.size() - 1;
             inserted = true;
         }
@@ -1470,13 +2399,13 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
+        auto it = find(name);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(name.begin(),name.end(),get_allocator()), 
                                         std::forward<T>(value),get_allocator());
+            index_insert(this->members_.size() - 1);
             it = this->members_.begin() + this->members_.size() - 1;
             inserted = true;
         }
@@ -1500,13 +2429,13 @@ public:
         }
         else
         {
-            it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [key](const value_type& a){return a.key() == key;});
+            it = find(key);
 
             if (it == this->members_.end())
             {
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end()), 
                                             std::forward<T>(value));
+                index_insert(this->members_.size() - 1);
                 it = this->members_.begin() + this->members_.size() - 1;
             }
             else
@@ -1529,13 +2458,13 @@ public:
         }
         else
         {
-            it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [key](const value_type& a){return a.key() == key;});
+            it = find(key);
 
             if (it == this->members_.end())
             {
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end(),get_allocator()), 
                                             std::forward<T>(value),get_allocator());
+                index_insert(this->members_.size() - 1);
                 it = this->members_.begin() + this->members_.size() - 1;
             }
             else
@@ -1562,11 +2491,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 this->members_.emplace_back(*it);
+                index_insert(this->members_.size() - 1);
             }
         }
     }
@@ -1585,11 +2514,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 hint = this->members_.emplace(hint,*it);
+                index_insert(hint - this->members_.begin());
             }
         }
     }
@@ -1610,11 +2539,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 this->members_.emplace_back(*it);
+                index_insert(this->members_.size() - 1);
             }
             else
             {
@@ -1637,11 +2566,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 hint = this->members_.emplace(hint,*it);
+                index_insert(hint - this->members_.begin());
             }
             else
             {
@@ -1657,13 +2586,13 @@ public:
     try_emplace(const string_view_type& key, Args&&... args)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(key.begin(),key.end()), 
                                         std::forward<Args>(args)...);
+            index_insert(this->members_.size() - 1);
             it = this->members_.begin() + this->members_.size() - 1;
             inserted = true;
 
@@ -1680,13 +2609,13 @@ public:
     try_emplace(const string_view_type& key, Args&&... args)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(key.begin(),key.end(), get_allocator()), 
                                         std::forward<Args>(args)...);
+            index_insert(this->members_.size() - 1);
             it = this->members_.begin() + this->members_.size() - 1;
             inserted = true;
 
@@ -1702,8 +2631,7 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type
     try_emplace(iterator hint, const string_view_type& key, Args&&... args)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
@@ -1719,6 +2647,7 @@ public:
                                             key_storage_type(key.begin(),key.end()), 
                                             std::forward<Args>(args)...);
             }
+            index_insert(it - this->members_.begin());
         }
         return it;
     }
@@ -1727,8 +2656,7 @@ public:
     typename std::enable_if<!is_stateless<A>::value,iterator>::type
     try_emplace(iterator hint, const string_view_type& key, Args&&... args)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
@@ -1744,6 +2672,7 @@ public:
                                             key_storage_type(key.begin(),key.end(), get_allocator()), 
                                             std::forward<Args>(args)...);
             }
+            index_insert(it - this->members_.begin());
         }
         return it;
     }
@@ -1755,13 +2684,13 @@ public:
     set_(key_storage_type&& key, T&& value)
     {
         string_view_type s(key.data(),key.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
+        auto it = find(s);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value));
+            index_insert(this->members_.size() - 1);
         }
         else
         {
@@ -1774,13 +2703,13 @@ public:
     set_(key_storage_type&& key, T&& value)
     {
         string_view_type s(key.data(),key.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
+        auto it = find(s);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value),get_allocator());
+            index_insert(this->members_.size() - 1);
         }
         else
         {
@@ -1799,6 +2728,7 @@ public:
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value));
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_insert(this->members_.size() - 1);
         }
         else if (it->key() == key)
         {
@@ -1809,6 +2739,7 @@ public:
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type>(key),
                                   std::forward<T>(value));
+            index_insert(it - this->members_.begin());
         }
         return it;
     }
@@ -1824,6 +2755,7 @@ public:
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value), get_allocator());
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_insert(this->members_.size() - 1);
         }
         else if (it->key() == key)
         {
@@ -1834,6 +2766,7 @@ public:
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type>(key),
                                   std::forward<T>(value), get_allocator());
+            index_insert(it - this->members_.begin());
         }
         return it;
     }
@@ -1846,17 +2779,154 @@ public:
         }
         for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
         {
-            auto rhs_it = std::find_if(rhs.begin(),rhs.end(), 
-                                       [it](const value_type& a){return a.key() == it->key();});
-            if (rhs_it == rhs.end() || rhs_it->key() != it->key() || rhs_it->value() != it->value())
+            auto rhs_it = rhs.find(it->key());
+            if (rhs_it == rhs.end() || rhs_it->value() != it->value())
             {
                 return false;
             }
         }
         return true;
     }
+
+    bool has_hash_index() const
+    {
+        return !index_.empty();
+    }
 private:
     json_object& operator=(const json_object&) = delete;
+
+    static size_t hash_key(const string_view_type& s)
+    {
+        // FNV-1a
+        uint64_t h = 14695981039346656037ULL;
+        for (auto c : s)
+        {
+            h ^= static_cast<uint64_t>(static_cast<typename std::make_unsigned<char_type>::type>(c));
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    size_t find_position(const string_view_type& name) const
+    {
+        if (index_.empty())
+        {
+            auto it = std::find_if(this->members_.begin(),this->members_.end(),
+                                   [name](const value_type& kv){return kv.key() == name;});
+            return it - this->members_.begin();
+        }
+        const auto& index = *index_;
+        size_t mask = index.size() - 1;
+        for (size_t i = hash_key(name) & mask; index[i] != 0; i = (i + 1) & mask)
+        {
+            if (this->members_[index[i] - 1].key() == name)
+            {
+                return index[i] - 1;
+            }
+        }
+        return this->members_.size();
+    }
+
+    // Rebuilds the index from members_, or frees it if the object is below the threshold
+
+    void build_index()
+    {
+        const size_t threshold = detail::object_hash_index_threshold_of<typename Json::implementation_policy>::value;
+        size_t n = this->members_.size();
+        if (threshold == 0 || n < threshold)
+        {
+            index_.clear(get_allocator());
+            return;
+        }
+        size_t capacity = 16;
+        while (capacity < 4*n)
+        {
+            capacity *= 2;
+        }
+        index_.get(get_allocator()).assign(capacity, 0);
+        for (size_t pos = 0; pos < n; ++pos)
+        {
+            place(pos);
+        }
+    }
+
+    void place(size_t pos)
+    {
+        auto& index = *index_;
+        size_t mask = index.size() - 1;
+        size_t i = hash_key(this->members_[pos].key()) & mask;
+        while (index[i] != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        index[i] = pos + 1;
+    }
+
+    // Records a member just inserted into members_ at pos
+
+    void index_insert(size_t pos)
+    {
+        if (index_.empty() || 2*this->members_.size() > (*index_).size())
+        {
+            build_index();
+            return;
+        }
+        if (pos + 1 < this->members_.size())
+        {
+            for (auto& slot : *index_)
+            {
+                if (slot > pos)
+                {
+                    ++slot;
+                }
+            }
+        }
+        place(pos);
+    }
+
+    // Removes the member at pos, which is about to be erased from members_, from the index.
+    // Later entries in the probe sequence are shifted back rather than leaving a tombstone.
+
+    void index_erase(size_t pos)
+    {
+        if (index_.empty())
+        {
+            return;
+        }
+        const size_t threshold = detail::object_hash_index_threshold_of<typename Json::implementation_policy>::value;
+        if (this->members_.size() <= threshold)
+        {
+            index_.clear(get_allocator());
+            return;
+        }
+        auto& index = *index_;
+        size_t mask = index.size() - 1;
+        size_t i = hash_key(this->members_[pos].key()) & mask;
+        while (index[i] != pos + 1)
+        {
+            i = (i + 1) & mask;
+        }
+        index[i] = 0;
+        for (size_t j = (i + 1) & mask; index[j] != 0; j = (j + 1) & mask)
+        {
+            size_t k = hash_key(this->members_[index[j] - 1].key()) & mask;
+            // Move the entry at j into the hole at i unless its home slot k lies cyclically in (i,j]
+            bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (!stays)
+            {
+                index[i] = index[j];
+                index[j] = 0;
+                i = j;
+            }
+        }
+        for (auto& slot : index)
+        {
+            if (slot > pos + 1)
+            {
+                --slot;
+            }
+        }
+    }
 };
 
 }
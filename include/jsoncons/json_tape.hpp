@@ -0,0 +1,916 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_HPP
+#define JSONCONS_JSON_TAPE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <istream>
+#include <iterator>
+#include <type_traits>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_filter.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+// Tape entries are 64 bits, a tag in the high byte and a payload in the rest. Containers
+// take one entry at each end, and the begin entry holds the index of the end entry, so a
+// whole container is skipped in one step. Strings are two entries, the offset of the
+// characters in the string arena and the length. Numbers are two entries, the tag
+// and the bits of the value.
+
+enum class tape_tag : uint8_t
+{
+    begin_object = 1,
+    end_object,
+    begin_array,
+    end_array,
+    string,
+    byte_string,
+    integer,
+    uinteger,
+    double_value,
+    true_value,
+    false_value,
+    null_value
+};
+
+const unsigned tape_tag_shift = 56;
+const uint64_t tape_payload_mask = (uint64_t(1) << tape_tag_shift) - 1;
+
+// Set in the length entry of a string that is a member name
+const uint64_t tape_name_flag = uint64_t(1) << 63;
+
+inline
+uint64_t make_tape_entry(tape_tag tag, uint64_t payload)
+{
+    return (static_cast<uint64_t>(tag) << tape_tag_shift) | (payload & tape_payload_mask);
+}
+
+inline
+tape_tag get_tape_tag(uint64_t entry)
+{
+    return static_cast<tape_tag>(entry >> tape_tag_shift);
+}
+
+inline
+uint64_t get_tape_payload(uint64_t entry)
+{
+    return entry & tape_payload_mask;
+}
+
+template <class View, class T, class Enable=void>
+struct json_tape_view_as;
+
+}
+
+template <class CharT>
+class basic_json_tape_view;
+
+// basic_json_tape_member
+
+template <class CharT>
+class basic_json_tape_member
+{
+public:
+    typedef typename basic_json_tape_view<CharT>::string_view_type string_view_type;
+private:
+    string_view_type key_;
+    basic_json_tape_view<CharT> value_;
+public:
+    basic_json_tape_member(const string_view_type& key, const basic_json_tape_view<CharT>& value)
+        : key_(key), value_(value)
+    {
+    }
+
+    string_view_type key() const
+    {
+        return key_;
+    }
+
+    const basic_json_tape_view<CharT>& value() const
+    {
+        return value_;
+    }
+};
+
+// basic_json_tape_view
+
+// A value in a basic_json_tape. Views are cheap to copy and are valid as long as the tape
+// they came from.
+
+template <class CharT>
+class basic_json_tape_view
+{
+public:
+    typedef CharT char_type;
+    typedef std::char_traits<char_type> char_traits_type;
+    typedef basic_string_view_ext<char_type,char_traits_type> string_view_type;
+    typedef basic_json_tape_member<CharT> member_type;
+
+    class array_iterator
+    {
+        const uint64_t* tape_;
+        const CharT* strings_;
+        const uint8_t* bytes_;
+        size_t index_;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef basic_json_tape_view<CharT> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+        array_iterator()
+            : tape_(nullptr), strings_(nullptr), bytes_(nullptr), index_(0)
+        {
+        }
+
+        array_iterator(const uint64_t* tape, const CharT* strings, const uint8_t* bytes, size_t index)
+            : tape_(tape), strings_(strings), bytes_(bytes), index_(index)
+        {
+        }
+
+        value_type operator*() const
+        {
+            return value_type(tape_, strings_, bytes_, index_);
+        }
+
+        array_iterator& operator++()
+        {
+            index_ = basic_json_tape_view<CharT>::next_index(tape_, index_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+    };
+
+    class object_iterator
+    {
+        const uint64_t* tape_;
+        const CharT* strings_;
+        const uint8_t* bytes_;
+        size_t index_;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef basic_json_tape_member<CharT> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+        object_iterator()
+            : tape_(nullptr), strings_(nullptr), bytes_(nullptr), index_(0)
+        {
+        }
+
+        object_iterator(const uint64_t* tape, const CharT* strings, const uint8_t* bytes, size_t index)
+            : tape_(tape), strings_(strings), bytes_(bytes), index_(index)
+        {
+        }
+
+        value_type operator*() const
+        {
+            return value_type(basic_json_tape_view<CharT>(tape_, strings_, bytes_, index_).as_string_view(),
+                              basic_json_tape_view<CharT>(tape_, strings_, bytes_, index_+2));
+        }
+
+        object_iterator& operator++()
+        {
+            index_ = basic_json_tape_view<CharT>::next_index(tape_, index_+2);
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+    };
+
+private:
+    const uint64_t* tape_;
+    const CharT* strings_;
+    const uint8_t* bytes_;
+    size_t index_;
+
+    template <class View, class T, class Enable>
+    friend struct detail::json_tape_view_as;
+public:
+    basic_json_tape_view(const uint64_t* tape, const CharT* strings, const uint8_t* bytes, size_t index)
+        : tape_(tape), strings_(strings), bytes_(bytes), index_(index)
+    {
+    }
+
+    bool is_object() const
+    {
+        return tag() == detail::tape_tag::begin_object;
+    }
+
+    bool is_array() const
+    {
+        return tag() == detail::tape_tag::begin_array;
+    }
+
+    bool is_string() const
+    {
+        return tag() == detail::tape_tag::string;
+    }
+
+    bool is_byte_string() const
+    {
+        return tag() == detail::tape_tag::byte_string;
+    }
+
+    bool is_integer() const
+    {
+        return tag() == detail::tape_tag::integer;
+    }
+
+    bool is_uinteger() const
+    {
+        return tag() == detail::tape_tag::uinteger;
+    }
+
+    bool is_double() const
+    {
+        return tag() == detail::tape_tag::double_value;
+    }
+
+    bool is_number() const
+    {
+        return is_integer() || is_uinteger() || is_double();
+    }
+
+    bool is_bool() const
+    {
+        return tag() == detail::tape_tag::true_value || tag() == detail::tape_tag::false_value;
+    }
+
+    bool is_null() const
+    {
+        return tag() == detail::tape_tag::null_value;
+    }
+
+    // The number of elements or members, found by stepping over them
+
+    size_t size() const
+    {
+        size_t count = 0;
+        if (is_array())
+        {
+            for (size_t i = index_ + 1; i < end_index(); i = next_index(tape_, i))
+            {
+                ++count;
+            }
+        }
+        else if (is_object())
+        {
+            for (size_t i = index_ + 1; i < end_index(); i = next_index(tape_, i+2))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool empty() const
+    {
+        return (is_array() || is_object()) ? end_index() == index_ + 1 : false;
+    }
+
+    range<array_iterator> array_range() const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an array");
+        }
+        return range<array_iterator>(array_iterator(tape_, strings_, bytes_, index_+1),
+                                     array_iterator(tape_, strings_, bytes_, end_index()));
+    }
+
+    range<object_iterator> object_range() const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an object");
+        }
+        return range<object_iterator>(object_iterator(tape_, strings_, bytes_, index_+1),
+                                      object_iterator(tape_, strings_, bytes_, end_index()));
+    }
+
+    basic_json_tape_view at(size_t i) const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an array");
+        }
+        size_t j = index_ + 1;
+        for (; i > 0 && j < end_index(); --i)
+        {
+            j = next_index(tape_, j);
+        }
+        if (j >= end_index())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::out_of_range,"Invalid array subscript");
+        }
+        return basic_json_tape_view(tape_, strings_, bytes_, j);
+    }
+
+    basic_json_tape_view at(const string_view_type& name) const
+    {
+        object_iterator it = find(name);
+        if (it == object_range().end())
+        {
+            JSONCONS_THROW_EXCEPTION(key_not_found(name.data(),name.length()));
+        }
+        return (*it).value();
+    }
+
+    basic_json_tape_view operator[](size_t i) const
+    {
+        return at(i);
+    }
+
+    basic_json_tape_view operator[](const string_view_type& name) const
+    {
+        return at(name);
+    }
+
+    // Returns the first member with the given name, or object_range().end()
+
+    object_iterator find(const string_view_type& name) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an object");
+        }
+        size_t i = index_ + 1;
+        while (i < end_index())
+        {
+            if (basic_json_tape_view(tape_, strings_, bytes_, i).as_string_view() == name)
+            {
+                break;
+            }
+            i = next_index(tape_, i+2);
+        }
+        return object_iterator(tape_, strings_, bytes_, i);
+    }
+
+    size_t count(const string_view_type& name) const
+    {
+        return find(name) == object_range().end() ? 0 : 1;
+    }
+
+    string_view_type as_string_view() const
+    {
+        if (!is_string())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a string");
+        }
+        return string_view_type(strings_ + detail::get_tape_payload(tape_[index_]),
+                                static_cast<size_t>(tape_[index_+1] & ~detail::tape_name_flag));
+    }
+
+    byte_string_view as_byte_string_view() const
+    {
+        if (!is_byte_string())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a byte string");
+        }
+        return byte_string_view(bytes_ + detail::get_tape_payload(tape_[index_]),
+                                static_cast<size_t>(tape_[index_+1]));
+    }
+
+    bool as_bool() const
+    {
+        switch (tag())
+        {
+        case detail::tape_tag::true_value:
+            return true;
+        case detail::tape_tag::false_value:
+            return false;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a bool");
+        }
+    }
+
+    int64_t as_integer() const
+    {
+        switch (tag())
+        {
+        case detail::tape_tag::integer:
+            return static_cast<int64_t>(tape_[index_+1]);
+        case detail::tape_tag::uinteger:
+            return static_cast<int64_t>(tape_[index_+1]);
+        case detail::tape_tag::double_value:
+            return static_cast<int64_t>(double_bits());
+        case detail::tape_tag::true_value:
+            return 1;
+        case detail::tape_tag::false_value:
+            return 0;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an integer");
+        }
+    }
+
+    uint64_t as_uinteger() const
+    {
+        switch (tag())
+        {
+        case detail::tape_tag::integer:
+        case detail::tape_tag::uinteger:
+            return tape_[index_+1];
+        case detail::tape_tag::double_value:
+            return static_cast<uint64_t>(double_bits());
+        case detail::tape_tag::true_value:
+            return 1;
+        case detail::tape_tag::false_value:
+            return 0;
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not an unsigned integer");
+        }
+    }
+
+    double as_double() const
+    {
+        switch (tag())
+        {
+        case detail::tape_tag::integer:
+            return static_cast<double>(static_cast<int64_t>(tape_[index_+1]));
+        case detail::tape_tag::uinteger:
+            return static_cast<double>(tape_[index_+1]);
+        case detail::tape_tag::double_value:
+            return double_bits();
+        default:
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Not a double");
+        }
+    }
+
+    template <class T>
+    T as() const
+    {
+        return detail::json_tape_view_as<basic_json_tape_view,T>::as(*this);
+    }
+
+    // Writes the events for this value, and its contents, to handler
+
+    void dump(basic_json_output_handler<CharT>& handler) const
+    {
+        handler.begin_json();
+        dump_fragment(handler);
+        handler.end_json();
+    }
+
+    void dump_fragment(basic_json_output_handler<CharT>& handler) const
+    {
+        size_t last = next_index(tape_, index_);
+        for (size_t i = index_; i < last; )
+        {
+            uint64_t entry = tape_[i];
+            switch (detail::get_tape_tag(entry))
+            {
+            case detail::tape_tag::begin_object:
+                handler.begin_object();
+                ++i;
+                break;
+            case detail::tape_tag::end_object:
+                handler.end_object();
+                ++i;
+                break;
+            case detail::tape_tag::begin_array:
+                handler.begin_array();
+                ++i;
+                break;
+            case detail::tape_tag::end_array:
+                handler.end_array();
+                ++i;
+                break;
+            case detail::tape_tag::string:
+                {
+                    string_view_type s(strings_ + detail::get_tape_payload(entry),
+                                       static_cast<size_t>(tape_[i+1] & ~detail::tape_name_flag));
+                    if ((tape_[i+1] & detail::tape_name_flag) != 0)
+                    {
+                        handler.name(s);
+                    }
+                    else
+                    {
+                        handler.string_value(s);
+                    }
+                    i += 2;
+                }
+                break;
+            case detail::tape_tag::byte_string:
+                handler.byte_string_value(bytes_ + detail::get_tape_payload(entry), static_cast<size_t>(tape_[i+1]));
+                i += 2;
+                break;
+            case detail::tape_tag::integer:
+                handler.integer_value(static_cast<int64_t>(tape_[i+1]));
+                i += 2;
+                break;
+            case detail::tape_tag::uinteger:
+                handler.uinteger_value(tape_[i+1]);
+                i += 2;
+                break;
+            case detail::tape_tag::double_value:
+                {
+                    double d;
+                    std::memcpy(&d, &tape_[i+1], sizeof(d));
+                    uint64_t payload = detail::get_tape_payload(entry);
+                    handler.double_value(d, number_format(static_cast<chars_format>((payload >> 16) & 0xff),
+                                                          static_cast<uint8_t>(payload & 0xff),
+                                                          static_cast<uint8_t>((payload >> 8) & 0xff)));
+                    i += 2;
+                }
+                break;
+            case detail::tape_tag::true_value:
+                handler.bool_value(true);
+                ++i;
+                break;
+            case detail::tape_tag::false_value:
+                handler.bool_value(false);
+                ++i;
+                break;
+            default:
+                handler.null_value();
+                ++i;
+                break;
+            }
+        }
+    }
+
+    // Builds a Json from this value and its contents
+
+    template <class Json>
+    Json to_json() const
+    {
+        json_decoder<Json> decoder;
+        basic_json_output_input_handler_adapter<CharT> adapter(decoder);
+        dump(adapter);
+        return decoder.get_result();
+    }
+
+    // Returns the index of the entry after the value starting at entry i
+
+    static size_t next_index(const uint64_t* tape, size_t i)
+    {
+        uint64_t entry = tape[i];
+        switch (detail::get_tape_tag(entry))
+        {
+        case detail::tape_tag::begin_object:
+        case detail::tape_tag::begin_array:
+            return static_cast<size_t>(detail::get_tape_payload(entry)) + 1;
+        case detail::tape_tag::string:
+        case detail::tape_tag::byte_string:
+        case detail::tape_tag::integer:
+        case detail::tape_tag::uinteger:
+        case detail::tape_tag::double_value:
+            return i + 2;
+        default:
+            return i + 1;
+        }
+    }
+
+private:
+    detail::tape_tag tag() const
+    {
+        return detail::get_tape_tag(tape_[index_]);
+    }
+
+    size_t end_index() const
+    {
+        return static_cast<size_t>(detail::get_tape_payload(tape_[index_]));
+    }
+
+    double double_bits() const
+    {
+        double d;
+        std::memcpy(&d, &tape_[index_+1], sizeof(d));
+        return d;
+    }
+};
+
+namespace detail {
+
+template <class View, class T>
+struct json_tape_view_as<View, T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T,bool>::value>::type>
+{
+    static T as(const View& v)
+    {
+        return static_cast<T>(v.as_integer());
+    }
+};
+
+template <class View, class T>
+struct json_tape_view_as<View, T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T,bool>::value>::type>
+{
+    static T as(const View& v)
+    {
+        return static_cast<T>(v.as_uinteger());
+    }
+};
+
+template <class View, class T>
+struct json_tape_view_as<View, T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static T as(const View& v)
+    {
+        return static_cast<T>(v.as_double());
+    }
+};
+
+template <class View>
+struct json_tape_view_as<View, bool>
+{
+    static bool as(const View& v)
+    {
+        return v.as_bool();
+    }
+};
+
+template <class View, class Traits, class Allocator>
+struct json_tape_view_as<View, std::basic_string<typename View::char_type,Traits,Allocator>>
+{
+    typedef std::basic_string<typename View::char_type,Traits,Allocator> string_type;
+
+    static string_type as(const View& v)
+    {
+        auto s = v.as_string_view();
+        return string_type(s.data(), s.length());
+    }
+};
+
+template <class View, class ImplementationPolicy, class Allocator>
+struct json_tape_view_as<View, basic_json<typename View::char_type,ImplementationPolicy,Allocator>>
+{
+    typedef basic_json<typename View::char_type,ImplementationPolicy,Allocator> json_type;
+
+    static json_type as(const View& v)
+    {
+        return v.template to_json<json_type>();
+    }
+};
+
+}
+
+// basic_json_tape
+
+// A parsed JSON text stored as a flat array of 64 bit entries (the tape), with the characters
+// of all strings in one arena. Building it allocates a few growing buffers rather than one
+// node per value. Values are read through basic_json_tape_view, and any subtree can be
+// turned into a basic_json with to_json.
+
+template <class CharT,class Allocator=std::allocator<char>>
+class basic_json_tape
+{
+public:
+    typedef CharT char_type;
+    typedef Allocator allocator_type;
+    typedef basic_json_tape_view<CharT> view_type;
+    typedef typename view_type::string_view_type string_view_type;
+private:
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t> tape_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t> byte_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<size_t> size_t_allocator_type;
+
+    std::vector<uint64_t,tape_allocator_type> tape_;
+    std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> strings_;
+    std::vector<uint8_t,byte_allocator_type> bytes_;
+
+    class builder : public basic_json_input_handler<CharT>
+    {
+        basic_json_tape& tape_;
+        std::vector<size_t,size_t_allocator_type> stack_;
+    public:
+        builder(basic_json_tape& tape)
+            : tape_(tape)
+        {
+        }
+
+        bool is_valid() const
+        {
+            return !tape_.tape_.empty() && stack_.empty();
+        }
+    private:
+        void do_begin_json() override
+        {
+            tape_.tape_.clear();
+            tape_.strings_.clear();
+            tape_.bytes_.clear();
+            stack_.clear();
+        }
+
+        void do_end_json() override
+        {
+        }
+
+        void do_begin_object(const parsing_context&) override
+        {
+            stack_.push_back(tape_.tape_.size());
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::begin_object, 0));
+        }
+
+        void do_end_object(const parsing_context&) override
+        {
+            end_container(detail::tape_tag::end_object);
+        }
+
+        void do_begin_array(const parsing_context&) override
+        {
+            stack_.push_back(tape_.tape_.size());
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::begin_array, 0));
+        }
+
+        void do_end_array(const parsing_context&) override
+        {
+            end_container(detail::tape_tag::end_array);
+        }
+
+        void do_name(const string_view_type& name, const parsing_context&) override
+        {
+            add_string(name, true);
+        }
+
+        void do_string_value(const string_view_type& value, const parsing_context&) override
+        {
+            add_string(value, false);
+        }
+
+        void do_byte_string_value(const uint8_t* data, size_t length, const parsing_context&) override
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::byte_string, tape_.bytes_.size()));
+            tape_.tape_.push_back(length);
+            tape_.bytes_.insert(tape_.bytes_.end(), data, data + length);
+        }
+
+        void do_double_value(double value, const number_format& fmt, const parsing_context&) override
+        {
+            uint64_t payload = static_cast<uint64_t>(fmt.precision())
+                             | (static_cast<uint64_t>(fmt.decimal_places()) << 8)
+                             | (static_cast<uint64_t>(fmt.floating_point_format()) << 16);
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::double_value, payload));
+            tape_.tape_.push_back(bits);
+        }
+
+        void do_integer_value(int64_t value, const parsing_context&) override
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::integer, 0));
+            tape_.tape_.push_back(static_cast<uint64_t>(value));
+        }
+
+        void do_uinteger_value(uint64_t value, const parsing_context&) override
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::uinteger, 0));
+            tape_.tape_.push_back(value);
+        }
+
+        void do_bool_value(bool value, const parsing_context&) override
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(value ? detail::tape_tag::true_value : detail::tape_tag::false_value, 0));
+        }
+
+        void do_null_value(const parsing_context&) override
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::null_value, 0));
+        }
+
+        void end_container(detail::tape_tag tag)
+        {
+            size_t begin = stack_.back();
+            stack_.pop_back();
+            size_t end = tape_.tape_.size();
+            tape_.tape_[begin] |= static_cast<uint64_t>(end);
+            tape_.tape_.push_back(detail::make_tape_entry(tag, begin));
+        }
+
+        void add_string(const string_view_type& s, bool is_name)
+        {
+            tape_.tape_.push_back(detail::make_tape_entry(detail::tape_tag::string, tape_.strings_.size()));
+            tape_.tape_.push_back(static_cast<uint64_t>(s.length()) | (is_name ? detail::tape_name_flag : 0));
+            tape_.strings_.append(s.data(), s.length());
+        }
+    };
+
+public:
+    basic_json_tape()
+    {
+        tape_.push_back(detail::make_tape_entry(detail::tape_tag::null_value, 0));
+    }
+
+    basic_json_tape(const basic_json_tape&) = default;
+    basic_json_tape(basic_json_tape&&) = default;
+    basic_json_tape& operator=(const basic_json_tape&) = default;
+    basic_json_tape& operator=(basic_json_tape&&) = default;
+
+    static basic_json_tape parse(const string_view_type& s)
+    {
+        default_parse_error_handler err_handler;
+        return parse(s, err_handler);
+    }
+
+    static basic_json_tape parse(const string_view_type& s, parse_error_handler& err_handler)
+    {
+        basic_json_tape tape;
+        builder handler(tape);
+        basic_json_parser<CharT,Allocator> parser(handler, err_handler);
+
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            throw parse_error(result.ec,1,1);
+        }
+        size_t offset = result.it - s.begin();
+        parser.set_source(s.data()+offset,s.size()-offset);
+        parser.parse();
+        parser.end_parse();
+        parser.check_done();
+        if (!handler.is_valid())
+        {
+            JSONCONS_THROW_EXCEPTION(json_runtime_error<std::runtime_error>("Failed to parse json string"));
+        }
+        return tape;
+    }
+
+    static basic_json_tape parse(std::basic_istream<CharT>& is)
+    {
+        default_parse_error_handler err_handler;
+        return parse(is, err_handler);
+    }
+
+    static basic_json_tape parse(std::basic_istream<CharT>& is, parse_error_handler& err_handler)
+    {
+        basic_json_tape tape;
+        builder handler(tape);
+        basic_json_reader<CharT,Allocator> reader(is, handler, err_handler);
+        reader.read_next();
+        reader.check_done();
+        if (!handler.is_valid())
+        {
+            JSONCONS_THROW_EXCEPTION(json_runtime_error<std::runtime_error>("Failed to parse json stream"));
+        }
+        return tape;
+    }
+
+    view_type root() const
+    {
+        return view_type(tape_.data(), strings_.data(), bytes_.data(), 0);
+    }
+
+    // The number of 64 bit entries in the tape
+
+    size_t tape_size() const
+    {
+        return tape_.size();
+    }
+
+    size_t string_arena_size() const
+    {
+        return strings_.size();
+    }
+};
+
+typedef basic_json_tape<char> json_tape;
+typedef basic_json_tape<wchar_t> wjson_tape;
+typedef basic_json_tape_view<char> json_tape_view;
+typedef basic_json_tape_view<wchar_t> wjson_tape_view;
+
+}
+
+#endif
@@ -538,6 +538,10 @@ struct json_type_traits<Json, T,
     static bool is(const Json& j) JSONCONS_NOEXCEPT
     {
         bool result = j.is_array();
+        if (result && j.array_value().template packed_data<element_type>() != nullptr)
+        {
+            return true;
+        }
         if (result)
         {
             for (auto e : j.array_range())
@@ -558,6 +562,11 @@ struct json_type_traits<Json, T,
     {
         if (j.is_array())
         {
+            const element_type* p = j.array_value().template packed_data<element_type>();
+            if (p != nullptr)
+            {
+                return T(p, p + j.size());
+            }
             T v(detail::json_array_input_iterator<Json, element_type>(j.array_range().begin()),
                 detail::json_array_input_iterator<Json, element_type>(j.array_range().end()));
             return v;
@@ -574,6 +583,11 @@ struct json_type_traits<Json, T,
     {
         if (j.is_array())
         {
+            const element_type* p = j.array_value().template packed_data<element_type>();
+            if (p != nullptr)
+            {
+                return T(p, p + j.size());
+            }
             T v(detail::json_array_input_iterator<Json, element_type>(j.array_range().begin()),
                 detail::json_array_input_iterator<Json, element_type>(j.array_range().end()));
             return v;
@@ -592,28 +606,14 @@ struct json_type_traits<Json, T,
     static Json to_json(const T& val)
     {
         Json j = typename Json::array();
-        auto first = std::begin(val);
-        auto last = std::end(val);
-        size_t size = std::distance(first,last);
-        j.reserve(size);
-        for (auto it = first; it != last; ++it)
-        {
-            j.push_back(*it);
-        }
+        j.array_value().assign_packed(std::begin(val), std::end(val));
         return j;
     }
 
     static Json to_json(const T& val, const allocator_type& allocator)
     {
         Json j = typename Json::array(allocator);
-        auto first = std::begin(val);
-        auto last = std::end(val);
-        size_t size = std::distance(first, last);
-        j.reserve(size);
-        for (auto it = first; it != last; ++it)
-        {
-            j.push_back(*it);
-        }
+        j.array_value().assign_packed(std::begin(val), std::end(val));
         return j;
     }
 };
@@ -635,7 +635,9 @@ struct json_type_traits<Json, T,
     {
         if (j.is_string())
         {
-			return j.as_string(string_allocator_type());
+            // T's allocator need not be the json value's
+            auto sv = j.as_string_view();
+            return T(sv.data(), sv.length(), string_allocator_type());
         }
         else
         {
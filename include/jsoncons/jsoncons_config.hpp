@@ -60,6 +60,30 @@ namespace jsoncons
 
 //#define JSONCONS_HAS_STRING_VIEW
 
+// Define JSONCONS_NO_SIMD to restrict the block scanners in detail/scanners.hpp to scalar code
+#if !defined(JSONCONS_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSONCONS_HAS_SSE2
+#elif (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#define JSONCONS_HAS_SWAR
+#endif
+#endif
+
+// Define JSONCONS_NO_MMAP to have mapped_file read files into memory instead of mapping them
+#if !defined(JSONCONS_NO_MMAP)
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+#define JSONCONS_HAS_MMAP
+#endif
+#endif
+
+// Define JSONCONS_NO_PMR to leave out the std::pmr based json types in pmr_json.hpp, which
+// are otherwise available when compiling as C++17 with a library that has <memory_resource>
+#if !defined(JSONCONS_NO_PMR) && defined(__has_include)
+#if __has_include(<memory_resource>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#define JSONCONS_HAS_PMR
+#endif
+#endif
+
 #if defined(ANDROID) || defined(__ANDROID__)
 #define JSONCONS_HAS_STRTOLD_L
 #define JSONCONS_NO_LOCALECONV
@@ -0,0 +1,155 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MAPPED_FILE_HPP
+#define JSONCONS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_utilities.hpp>
+
+#if defined(JSONCONS_HAS_MMAP)
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+// The read only contents of a file, memory mapped where JSONCONS_HAS_MMAP is defined and
+// read into memory otherwise, for handing to a parser or reader as a single source
+
+class mapped_file
+{
+public:
+    typedef basic_string_view_ext<char> string_view_type;
+private:
+    const char* data_;
+    size_t size_;
+#if defined(JSONCONS_HAS_MMAP)
+    void* mapping_;
+#else
+    std::vector<char> buffer_;
+#endif
+
+    // Noncopyable and nonmoveable
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+public:
+    mapped_file(const std::string& filename)
+        : data_(""), size_(0)
+#if defined(JSONCONS_HAS_MMAP)
+        , mapping_(nullptr)
+#endif
+    {
+        std::error_code ec;
+        open(filename, ec);
+        if (ec)
+        {
+            throw std::system_error(ec, filename);
+        }
+    }
+
+    mapped_file(const std::string& filename, std::error_code& ec)
+        : data_(""), size_(0)
+#if defined(JSONCONS_HAS_MMAP)
+        , mapping_(nullptr)
+#endif
+    {
+        open(filename, ec);
+    }
+
+    ~mapped_file()
+    {
+#if defined(JSONCONS_HAS_MMAP)
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, size_);
+        }
+#endif
+    }
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    string_view_type view() const
+    {
+        return string_view_type(data_, size_);
+    }
+
+private:
+#if defined(JSONCONS_HAS_MMAP)
+    void open(const std::string& filename, std::error_code& ec)
+    {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            ec = std::error_code(errno, std::system_category());
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            ec = std::error_code(errno, std::system_category());
+            ::close(fd);
+            return;
+        }
+        if (st.st_size > 0)
+        {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ec = std::error_code(errno, std::system_category());
+                ::close(fd);
+                return;
+            }
+            // The parser reads the mapping front to back, once
+            ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            mapping_ = p;
+            data_ = static_cast<const char*>(p);
+            size_ = static_cast<size_t>(st.st_size);
+        }
+        ::close(fd);
+    }
+#else
+    void open(const std::string& filename, std::error_code& ec)
+    {
+        std::ifstream is(filename, std::ios::in | std::ios::binary);
+        if (!is)
+        {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            return;
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        if (is.bad())
+        {
+            ec = std::make_error_code(std::errc::io_error);
+            return;
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,320 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_PARSE_HPP
+#define JSONCONS_PARALLEL_PARSE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/thread_pool.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+template <class CharT>
+bool is_json_blank(CharT c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Guesses the position of a comma that separates two elements of the top level array,
+// looking in [first,last), where first may be anywhere in the text that starts at begin,
+// including inside a string. Strings are tracked from the first unescaped quotation mark, taken to close a
+// string if a reverse solidus comes before it, or if it is followed by a name separator,
+// value separator or closing bracket and not preceded by an opening bracket, separator
+// or colon. Of the commas found, the first at the lowest
+// nesting depth is chosen. Returns last if there are none.
+
+template <class CharT>
+const CharT* guess_element_boundary(const CharT* begin, const CharT* first, const CharT* last)
+{
+    bool in_string = false;
+
+    // A reverse solidus can only appear inside a string
+    bool escaped = false;
+    const CharT* q = first;
+    while (q != last && *q != '\"')
+    {
+        if (*q == '\\')
+        {
+            escaped = true;
+            if (++q == last)
+            {
+                break;
+            }
+        }
+        ++q;
+    }
+    if (escaped)
+    {
+        in_string = true;
+    }
+    else if (q != last)
+    {
+        const CharT* next = q + 1;
+        while (next != last && is_json_blank(*next))
+        {
+            ++next;
+        }
+        const CharT* prev = q;
+        while (prev != begin && is_json_blank(*(prev-1)))
+        {
+            --prev;
+        }
+        bool closes = next != last && (*next == ':' || *next == ',' || *next == '}' || *next == ']');
+        bool opens = prev != begin && (*(prev-1) == '[' || *(prev-1) == '{' || *(prev-1) == ',' || *(prev-1) == ':');
+        if (closes && !opens)
+        {
+            in_string = true;
+        }
+    }
+
+    const CharT* boundary = last;
+    int depth = 0;
+    int boundary_depth = 0;
+    for (const CharT* p = first; p != last; ++p)
+    {
+        if (in_string)
+        {
+            if (*p == '\\')
+            {
+                if (++p == last)
+                {
+                    break;
+                }
+            }
+            else if (*p == '\"')
+            {
+                in_string = false;
+            }
+            continue;
+        }
+        switch (*p)
+        {
+        case '\"':
+            in_string = true;
+            break;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        case '}':
+        case ']':
+            --depth;
+            break;
+        case ',':
+            if (boundary == last || depth < boundary_depth)
+            {
+                boundary = p;
+                boundary_depth = depth;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return boundary;
+}
+
+// Parses [first,last) as the elements of an array, into result. The range must not be
+// blank, an empty range between two commas is not valid JSON.
+
+template <class Json>
+bool parse_array_elements(const typename Json::char_type* first, const typename Json::char_type* last, Json& result)
+{
+    typedef typename Json::char_type char_type;
+    static const char_type begin_array[] = {'['};
+    static const char_type end_array[] = {']'};
+
+    const char_type* p = first;
+    while (p != last && is_json_blank(*p))
+    {
+        ++p;
+    }
+    if (p == last)
+    {
+        return false;
+    }
+
+    strict_parse_error_handler err_handler;
+    static_json_decoder<Json> decoder;
+    basic_json_parser<char_type,std::allocator<char>,static_json_decoder<Json>> parser(decoder, err_handler);
+
+    std::error_code ec;
+    parser.set_source(begin_array, 1);
+    parser.parse(ec);
+    if (ec) return false;
+    parser.set_source(first, last - first);
+    parser.parse(ec);
+    if (ec || parser.done()) return false;
+    parser.set_source(end_array, 1);
+    parser.parse(ec);
+    if (ec) return false;
+    parser.end_parse(ec);
+    if (ec || !decoder.is_valid()) return false;
+    result = decoder.get_result();
+    return true;
+}
+
+}
+
+// Parses text whose top level value is an array, splitting the elements among num_threads
+// workers. Element boundaries are guessed with detail::guess_element_boundary, and each range
+// of elements is parsed as an array on its own. If every range parses the guesses were right
+// and the elements are moved into one array. Otherwise, and for text that is not an array
+// or is too short to split, the text is parsed serially with Json::parse.
+
+template <class Json>
+Json parallel_parse(const typename Json::string_view_type& s,
+                    size_t num_threads,
+                    parse_error_handler& err_handler)
+{
+    typedef typename Json::char_type char_type;
+    static const size_t min_range_length = 16384;
+    static const size_t max_boundary_search = 1024*1024;
+
+    const char_type* first = s.data();
+    const char_type* last = s.data() + s.length();
+
+    auto bom = unicons::skip_bom(first, last);
+    if (bom.ec == unicons::encoding_errc())
+    {
+        first = bom.it;
+    }
+    while (first != last && detail::is_json_blank(*first))
+    {
+        ++first;
+    }
+    while (last != first && detail::is_json_blank(*(last-1)))
+    {
+        --last;
+    }
+
+    if (num_threads > static_cast<size_t>(last - first)/min_range_length)
+    {
+        num_threads = static_cast<size_t>(last - first)/min_range_length;
+    }
+    if (num_threads < 2 || *first != '[' || *(last-1) != ']')
+    {
+        return Json::parse(s, err_handler);
+    }
+    ++first;
+    --last;
+
+    // Range i is [bounds[i]+1,bounds[i+1]), with the array's brackets as the outer bounds
+    std::vector<const char_type*> bounds;
+    bounds.push_back(first - 1);
+    const size_t length = static_cast<size_t>(last - first);
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        const char_type* target = first + i*(length/num_threads);
+        if (target <= bounds.back())
+        {
+            continue;
+        }
+        const char_type* limit = first + (i+1)*(length/num_threads);
+        if (static_cast<size_t>(limit - target) > max_boundary_search)
+        {
+            limit = target + max_boundary_search;
+        }
+        const char_type* boundary = detail::guess_element_boundary(first, target, limit);
+        if (boundary != limit)
+        {
+            bounds.push_back(boundary);
+        }
+    }
+    bounds.push_back(last);
+
+    const size_t num_ranges = bounds.size() - 1;
+    if (num_ranges < 2)
+    {
+        return Json::parse(s, err_handler);
+    }
+
+    std::vector<Json> results(num_ranges);
+    std::vector<char> succeeded(num_ranges, 0);
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining = num_ranges;
+    {
+        detail::thread_pool pool(num_ranges - 1);
+        for (size_t i = 1; i < num_ranges; ++i)
+        {
+            pool.submit([&,i]
+            {
+                bool ok = false;
+                try
+                {
+                    ok = detail::parse_array_elements(bounds[i]+1, bounds[i+1], results[i]);
+                }
+                catch (...)
+                {
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                succeeded[i] = ok;
+                --remaining;
+                cv.notify_one();
+            });
+        }
+        bool ok = false;
+        try
+        {
+            ok = detail::parse_array_elements(bounds[0]+1, bounds[1], results[0]);
+        }
+        catch (...)
+        {
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        succeeded[0] = ok;
+        --remaining;
+        cv.wait(lock, [&]{return remaining == 0;});
+    }
+
+    for (size_t i = 0; i < num_ranges; ++i)
+    {
+        if (!succeeded[i])
+        {
+            return Json::parse(s, err_handler);
+        }
+    }
+
+    Json result = std::move(results[0]);
+    size_t size = 0;
+    for (const auto& r : results)
+    {
+        size += r.size();
+    }
+    result.reserve(size);
+    for (size_t i = 1; i < num_ranges; ++i)
+    {
+        for (auto& element : results[i].array_range())
+        {
+            result.push_back(std::move(element));
+        }
+        results[i] = Json();
+    }
+    return result;
+}
+
+template <class Json>
+Json parallel_parse(const typename Json::string_view_type& s,
+                    size_t num_threads = detail::thread_pool::default_size())
+{
+    typename Json::parse_error_handler_type err_handler;
+    return parallel_parse<Json>(s, num_threads, err_handler);
+}
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PMR_JSON_HPP
+#define JSONCONS_PMR_JSON_HPP
+
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/json.hpp>
+
+#if defined(JSONCONS_HAS_PMR)
+
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace jsoncons { namespace pmr {
+
+// polymorphic_allocator
+
+// A std::pmr::polymorphic_allocator that constructs objects with the arguments it is given.
+// basic_json passes allocators to the values it constructs itself, and the uses-allocator
+// construction of std::pmr::polymorphic_allocator::construct would pass a second one.
+
+template <class T>
+class polymorphic_allocator : public std::pmr::polymorphic_allocator<T>
+{
+public:
+    typedef T value_type;
+
+    polymorphic_allocator() noexcept = default;
+
+    polymorphic_allocator(std::pmr::memory_resource* resource) noexcept
+        : std::pmr::polymorphic_allocator<T>(resource)
+    {
+    }
+
+    polymorphic_allocator(const polymorphic_allocator&) = default;
+
+    template <class U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+        : std::pmr::polymorphic_allocator<T>(other.resource())
+    {
+    }
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    // A copy of a container uses the same resource as the original, as copies of basic_json
+    // values do, rather than the default resource
+    polymorphic_allocator select_on_container_copy_construction() const
+    {
+        return *this;
+    }
+};
+
+// The json types differ from json, wjson, ojson and wojson only in their allocator. The memory
+// resource is chosen at run time, for example a std::pmr::monotonic_buffer_resource per
+// request or a std::pmr::unsynchronized_pool_resource per thread, by passing an allocator
+// to json_decoder or to the basic_json constructors. Values created without one use
+// std::pmr::get_default_resource().
+
+typedef basic_json<char,sorted_policy,polymorphic_allocator<char>> json;
+typedef basic_json<wchar_t,sorted_policy,polymorphic_allocator<wchar_t>> wjson;
+typedef basic_json<char,preserve_order_policy,polymorphic_allocator<char>> ojson;
+typedef basic_json<wchar_t,preserve_order_policy,polymorphic_allocator<wchar_t>> wojson;
+
+}}
+
+#endif
+
+#endif
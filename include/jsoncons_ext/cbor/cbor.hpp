@@ -15,8 +15,16 @@
 #include <memory>
 #include <limits>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/binary/binary_utilities.hpp>
+#include <jsoncons_ext/cbor/cbor_serializer.hpp>
+#include <jsoncons_ext/cbor/cbor_parser.hpp>
 
 // Positive integer 0x00..0x17 (0..23)
 #define JSONCONS_CBOR_0x00_0x17 \
@@ -47,56 +55,47 @@ namespace jsoncons { namespace cbor {
 namespace detail {
     const uint8_t* walk(const uint8_t* it, const uint8_t* end);
 
+    // Returns a view of the definite length text string at it, in place, and where it ends
     inline 
-    std::tuple<std::string,const uint8_t*> get_fixed_length_text_string(const uint8_t* it, const uint8_t* end)
+    std::tuple<basic_string_view_ext<char>,const uint8_t*> get_fixed_length_text_string_view(const uint8_t* it, const uint8_t* end)
     {
         const uint8_t* pos = it++;
+        size_t len;
         switch (*pos)
         {       
         case JSONCONS_CBOR_0x60_0x77: // UTF-8 string (0x00..0x17 bytes follow)
-            {
-                size_t len = *pos & 0x1f;
-                const uint8_t *first = it;
-                it += len;
-                return std::make_tuple(std::string(first, it), it);
-            }
+            len = *pos & 0x1f;
+            break;
         case 0x78: // UTF-8 string (one-byte uint8_t for n follows)
-            {
-                const auto len = binary::detail::from_big_endian<uint8_t>(it,end);
-                it += sizeof(uint8_t);
-                const uint8_t *first = it;
-                it += len;
-                return std::make_tuple(std::string(first, it), it);
-            }
+            len = binary::detail::from_big_endian<uint8_t>(it,end);
+            it += sizeof(uint8_t);
+            break;
         case 0x79: // UTF-8 string (two-byte uint16_t for n follow)
-            {
-                const auto len = binary::detail::from_big_endian<uint16_t>(it,end);
-                it += sizeof(uint16_t);
-                const uint8_t* first = it;
-                it += len;
-                return std::make_tuple(std::string(first,it),it);
-            }
+            len = binary::detail::from_big_endian<uint16_t>(it,end);
+            it += sizeof(uint16_t);
+            break;
         case 0x7a: // UTF-8 string (four-byte uint32_t for n follow)
-            {
-                const auto len = binary::detail::from_big_endian<uint32_t>(it,end);
-                it += sizeof(uint32_t);
-                const uint8_t* first = it;
-                it += len;
-                return std::make_tuple(std::string(first,it),it);
-            }
+            len = binary::detail::from_big_endian<uint32_t>(it,end);
+            it += sizeof(uint32_t);
+            break;
         case 0x7b: // UTF-8 string (eight-byte uint64_t for n follow)
-            {
-                const auto len = binary::detail::from_big_endian<uint64_t>(it,end);
-                it += sizeof(uint64_t);
-                const uint8_t* first = it;
-                it += len;
-                return std::make_tuple(std::string(first,it),it);
-            }
+            len = static_cast<size_t>(binary::detail::from_big_endian<uint64_t>(it,end));
+            it += sizeof(uint64_t);
+            break;
         default: 
             {
                 JSONCONS_THROW_EXCEPTION_1(std::invalid_argument,"Error decoding a cbor at position %s", std::to_string(end-pos));
             }
         }
+        return std::make_tuple(basic_string_view_ext<char>(reinterpret_cast<const char*>(it), len), it + len);
+    }
+
+    inline 
+    std::tuple<std::string,const uint8_t*> get_fixed_length_text_string(const uint8_t* it, const uint8_t* end)
+    {
+        basic_string_view_ext<char> sv;
+        std::tie(sv,it) = get_fixed_length_text_string_view(it, end);
+        return std::make_tuple(std::string(sv.data(), sv.length()), it);
     }
 
     inline
@@ -109,23 +108,36 @@ namespace detail {
         case 0x7f: // UTF-8 string (0x00..0x17 bytes follow)
             {
                 std::string s;
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
-                    if (it == end)
-                    {
-                        JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
-                    }
                     std::string ss;
                     std::tie(ss,it) = detail::get_fixed_length_text_string(it,end);
                     s.append(std::move(ss));
                 }
-                return std::make_tuple(s,it);
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return std::make_tuple(s,it+1);
             }
         default:
             return detail::get_fixed_length_text_string(pos,end);
         }
     }
 
+    // Returns a view of the text string at it, and where it ends. A definite length string is
+    // viewed in place, one in chunks is put together in buffer and viewed there.
+    inline
+    std::tuple<basic_string_view_ext<char>,const uint8_t*> get_text_string_view(const uint8_t* it, const uint8_t* end, std::string& buffer)
+    {
+        if (it < end && *it == 0x7f)
+        {
+            std::tie(buffer,it) = get_text_string(it, end);
+            return std::make_tuple(basic_string_view_ext<char>(buffer.data(), buffer.length()), it);
+        }
+        return get_fixed_length_text_string_view(it, end);
+    }
+
     inline 
     std::tuple<std::vector<uint8_t>,const uint8_t*> get_fixed_length_byte_string(const uint8_t* it, const uint8_t* end)
     {
@@ -189,17 +201,17 @@ namespace detail {
         case 0x5f: // byte string, byte strings follow, terminated by "break"
             {
                 std::vector<uint8_t> v;
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
-                    if (it == end)
-                    {
-                        JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
-                    }
                     std::vector<uint8_t> ss;
                     std::tie(ss,it) = detail::get_fixed_length_byte_string(it,end);
                     v.insert(v.end(),ss.begin(),ss.end());
                 }
-                return std::make_tuple(v,it);
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return std::make_tuple(v,it+1);
             }
         default:
             return detail::get_fixed_length_byte_string(pos,end);
@@ -289,7 +301,7 @@ namespace detail {
     inline 
     bool is_object(uint8_t b) 
     {
-        return (b >= 0xa0 && b <= 0xbb) || b == 0xb8;
+        return (b >= 0xa0 && b <= 0xbb) || b == 0xbf;
     }
 
     inline const uint8_t* walk(const uint8_t* it, const uint8_t* end)
@@ -403,15 +415,15 @@ namespace detail {
             
         case 0x5f: // byte string (indefinite length)
             {
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
-                    if (it == end)
-                    {
-                        JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
-                    }
                     it = walk(it, end);
                 }
-                return it;
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return it + 1; // skip the break
             }
 
         // UTF-8 string (0x00..0x17 bytes follow)
@@ -451,15 +463,15 @@ namespace detail {
             // UTF-8 string (indefinite length)
         case 0x7f:
             {
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
-                    if (it == end)
-                    {
-                        JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
-                    }
                     it = walk(it, end);
                 }
-                return it;
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return it + 1; // skip the break
             }
 
             // array (0x00..0x17 data items follow)
@@ -503,11 +515,15 @@ namespace detail {
             // array (indefinite length)
         case 0x9f:
             {
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
                     it = walk(it, end);
                 }
-                return it;
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return it + 1; // skip the break
             }
 
             // map (0x00..0x17 pairs of data items follow)
@@ -551,12 +567,16 @@ namespace detail {
             // map (indefinite length)
         case 0xbf:
             {
-                while (*it != 0xff)
+                while (it < end && *it != 0xff)
                 {
                     it = walk(it, end);
                     it = walk(it, end);
                 }
-                return it;
+                if (it >= end)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                return it + 1; // skip the break
             }
 
             // False
@@ -653,12 +673,11 @@ namespace detail {
         case 0x9f: 
         {
             size_t len = 0;
-            while (*it != 0xff)
+            const uint8_t* p = it;
+            while (p < end && *p != 0xff)
             {
-                size_t sz;
-                std::tie(sz,it) = size(it,end);
-                len += sz;
-                it = walk(it, end);
+                p = walk(p, end);
+                ++len;
             }
             return std::make_tuple(len,it);
         }
@@ -705,10 +724,12 @@ namespace detail {
         case 0xbf: 
         {
             size_t len = 0;
-            while (*it != 0xff)
+            const uint8_t* p = it;
+            while (p < end && *p != 0xff)
             {
-                it = walk(it, end);
-                it = walk(it, end);
+                p = walk(p, end);
+                p = walk(p, end);
+                ++len;
             }
             return std::make_tuple(len,it);
         }
@@ -718,12 +739,62 @@ namespace detail {
     }
 }
 
+namespace detail {
+
+    // Side index of a cbor array or map, built once a view of a large one is looked into
+
+    struct cbor_container_index
+    {
+        // The number of elements, or of entries of a map
+        size_t size;
+        // Where each element, or each key and each value of a map, begins, followed by where the
+        // last one ends, as offsets from the start of the container
+        std::vector<size_t> offsets;
+        // The text string keys of a map with their entry numbers, in key order. Keys are viewed in
+        // the buffer, or in assembled_keys if they were in chunks.
+        std::vector<std::pair<basic_string_view_ext<char>,size_t>> keys;
+        std::deque<std::string> assembled_keys;
+    };
+
+    // The indexes built for the containers of one buffer, found by where they start. A view and
+    // the views it hands out share one, so repeated queries through them find the indexes built
+    // by earlier ones.
+
+    class cbor_index_cache
+    {
+        std::mutex mutex_;
+        std::unordered_map<const uint8_t*,std::shared_ptr<const cbor_container_index>> indexes_;
+    public:
+        std::shared_ptr<const cbor_container_index> find(const uint8_t* p)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = indexes_.find(p);
+            return it != indexes_.end() ? it->second : std::shared_ptr<const cbor_container_index>();
+        }
+
+        void insert(const uint8_t* p, std::shared_ptr<const cbor_container_index> index)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            indexes_.emplace(p, std::move(index));
+        }
+    };
+}
+
+class cbor_array_iterator;
+class cbor_object_iterator;
+
 // cbor_view
 
 class cbor_view 
 {
     const uint8_t* buffer_;
     size_t buflen_; 
+    mutable std::shared_ptr<detail::cbor_index_cache> cache_;
+
+    cbor_view(const uint8_t* buffer, size_t buflen, const std::shared_ptr<detail::cbor_index_cache>& cache)
+        : buffer_(buffer), buflen_(buflen), cache_(cache)
+    {
+    }
 public:
     typedef cbor_view value_type;
     typedef cbor_view& reference;
@@ -734,6 +805,14 @@ public:
     typedef char char_type;
     typedef std::char_traits<char_type> char_traits_type;
     typedef basic_string_view_ext<char_type> string_view_type;
+    typedef cbor_array_iterator const_array_iterator;
+    typedef cbor_object_iterator const_object_iterator;
+    // What a cbor_view decodes into, when a JSONPath query needs a value
+    typedef json json_type;
+
+    // Arrays and maps with fewer elements are searched by walking them, larger ones through an
+    // index of their elements, built on the first lookup into them
+    static const size_t index_threshold = 16;
 
     cbor_view()
         : buffer_(nullptr), buflen_(0)
@@ -751,9 +830,8 @@ public:
     }
 
     cbor_view(const cbor_view& other)
-        : buffer_(other.buffer_), buflen_(other.buflen_)
+        : buffer_(other.buffer_), buflen_(other.buflen_), cache_(std::atomic_load(&other.cache_))
     {
-
     }
 
     cbor_view(cbor_view&& other)
@@ -761,9 +839,19 @@ public:
     {
         std::swap(buffer_,other.buffer_);
         std::swap(buflen_,other.buflen_);
+        cache_.swap(other.cache_);
     }
 
-    cbor_view& operator=(const cbor_view&) = default;
+    cbor_view& operator=(const cbor_view& other)
+    {
+        if (this != &other)
+        {
+            buffer_ = other.buffer_;
+            buflen_ = other.buflen_;
+            cache_ = std::atomic_load(&other.cache_);
+        }
+        return *this;
+    }
 
     cbor_view& operator=(cbor_view&& other)
     {
@@ -771,6 +859,7 @@ public:
         {
             std::swap(buffer_,other.buffer_);
             std::swap(buflen_,other.buflen_);
+            cache_.swap(other.cache_);
         }
         return *this;
     }
@@ -797,22 +886,52 @@ public:
         return detail::is_object(buffer_[0]);
     }
 
+    bool is_string() const
+    {
+        JSONCONS_ASSERT(buflen_ > 0);
+        return detail::is_string(buffer_[0]);
+    }
+
+    // Decodes the value into a Json, such as json or ojson
+    template <class Json>
+    Json as() const;
+
     size_t size() const
     {
+        std::shared_ptr<const detail::cbor_container_index> container_index = find_index();
+        if (container_index)
+        {
+            return container_index->size;
+        }
         size_t len;
         const uint8_t* it;
         std::tie(len, it) = detail::size(buffer_,buffer_+buflen_);
         return len;
     }
 
+    range<const_array_iterator> array_range() const;
+
+    range<const_object_iterator> object_range() const;
+
     cbor_view at(size_t index) const
     {
         JSONCONS_ASSERT(is_array());
-        size_t len;
-        const uint8_t* it = buffer_;
+        const uint8_t* it;
         const uint8_t* end = buffer_ + buflen_;
+        std::shared_ptr<detail::cbor_index_cache> cache;
+        std::shared_ptr<const detail::cbor_container_index> container_index;
 
-        std::tie(len, it) = detail::size(it, end);
+        size_t len = get_size(it, cache, container_index);
+        if (index >= len)
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::out_of_range,"Index out of range");
+        }
+
+        if (container_index)
+        {
+            const auto& offsets = container_index->offsets;
+            return cbor_view(buffer_ + offsets[index], offsets[index+1] - offsets[index], cache);
+        }
 
         for (size_t i = 0; i < index; ++i)
         {
@@ -821,27 +940,40 @@ public:
 
         const uint8_t* last = detail::walk(it,end);
 
-        return cbor_view(it,last-it);
+        return cbor_view(it,last-it,std::atomic_load(&cache_));
     }
 
     cbor_view at(const string_view_type& key) const
     {
         JSONCONS_ASSERT(is_object());
-        size_t len;
-        const uint8_t* it = buffer_;
+        const uint8_t* it;
         const uint8_t* end = buffer_ + buflen_;
+        std::shared_ptr<detail::cbor_index_cache> cache;
+        std::shared_ptr<const detail::cbor_container_index> container_index;
+
+        size_t len = get_size(it, cache, container_index);
 
-        std::tie(len, it) = detail::size(buffer_, end);
+        if (container_index)
+        {
+            size_t entry;
+            if (find_key(*container_index, key, entry))
+            {
+                const auto& offsets = container_index->offsets;
+                return cbor_view(buffer_ + offsets[2*entry+1], offsets[2*entry+2] - offsets[2*entry+1], cache);
+            }
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Key not found");
+        }
 
+        string_type buffer;
         for (size_t i = 0; i < len; ++i)
         {
-            string_type a_key;
-            std::tie(a_key,it) = detail::get_fixed_length_text_string(it, end);
+            string_view_type a_key;
+            std::tie(a_key,it) = detail::get_text_string_view(it, end, buffer);
             if (a_key == key)
             {
                 const uint8_t* last = detail::walk(it, end);
                 JSONCONS_ASSERT(last >= it);
-                return cbor_view(it,last-it);
+                return cbor_view(it,last-it,std::atomic_load(&cache_));
             }
             const uint8_t* last = detail::walk(it, end);
             it = last;
@@ -855,16 +987,24 @@ public:
         {
             return false;
         }
-        size_t len;
-        const uint8_t* it = buffer_;
+        const uint8_t* it;
         const uint8_t* end = buffer_ + buflen_;
+        std::shared_ptr<detail::cbor_index_cache> cache;
+        std::shared_ptr<const detail::cbor_container_index> container_index;
 
-        std::tie(len, it) = detail::size(it, end);
+        size_t len = get_size(it, cache, container_index);
+
+        if (container_index)
+        {
+            size_t entry;
+            return find_key(*container_index, key, entry);
+        }
 
+        string_type buffer;
         for (size_t i = 0; i < len; ++i)
         {
-            string_type a_key;
-            std::tie(a_key,it) = detail::get_fixed_length_text_string(it, end);
+            string_view_type a_key;
+            std::tie(a_key,it) = detail::get_text_string_view(it, end, buffer);
             if (a_key == key)
             {
                 return true;
@@ -873,8 +1013,356 @@ public:
         }
         return false;
     }
+
+private:
+    // Returns the index of this indefinite length array or map if one has been built, else null.
+    // Finding the size of a definite length one takes no walk, so its index is not looked for.
+    std::shared_ptr<const detail::cbor_container_index> find_index() const
+    {
+        if (buflen_ == 0 || (buffer_[0] != 0x9f && buffer_[0] != 0xbf))
+        {
+            return nullptr;
+        }
+        std::shared_ptr<detail::cbor_index_cache> cache = std::atomic_load(&cache_);
+        return cache ? cache->find(buffer_) : nullptr;
+    }
+
+    // Returns the number of elements of this array or map, and sets first to where they begin.
+    // If it has index_threshold elements or more, sets container_index to its index, building it
+    // if need be. An indefinite length one with an index has its size looked up rather than
+    // walked, so that repeated lookups into it take constant or logarithmic time.
+    size_t get_size(const uint8_t*& first,
+                    std::shared_ptr<detail::cbor_index_cache>& cache,
+                    std::shared_ptr<const detail::cbor_container_index>& container_index) const
+    {
+        container_index = find_index();
+        if (container_index)
+        {
+            cache = std::atomic_load(&cache_);
+            first = buffer_ + container_index->offsets[0];
+            return container_index->size;
+        }
+        size_t len;
+        std::tie(len, first) = detail::size(buffer_, buffer_ + buflen_);
+        if (len >= index_threshold)
+        {
+            container_index = get_index(cache);
+        }
+        return len;
+    }
+
+    // Returns the index of this array or map, building it if no view sharing the cache has.
+    // Views racing to build it build equal ones, and the first stored is kept.
+    std::shared_ptr<const detail::cbor_container_index> get_index(std::shared_ptr<detail::cbor_index_cache>& cache) const
+    {
+        cache = std::atomic_load(&cache_);
+        if (!cache)
+        {
+            cache = std::make_shared<detail::cbor_index_cache>();
+            std::atomic_store(&cache_, cache);
+        }
+        std::shared_ptr<const detail::cbor_container_index> container_index = cache->find(buffer_);
+        if (!container_index)
+        {
+            container_index = build_index();
+            cache->insert(buffer_, container_index);
+        }
+        return container_index;
+    }
+
+    std::shared_ptr<const detail::cbor_container_index> build_index() const
+    {
+        auto container_index = std::make_shared<detail::cbor_container_index>();
+        size_t len;
+        const uint8_t* it = buffer_;
+        const uint8_t* end = buffer_ + buflen_;
+        std::tie(len, it) = detail::size(it, end);
+        container_index->size = len;
+
+        const bool is_map = is_object();
+        container_index->offsets.reserve(is_map ? 2*len+1 : len+1);
+        for (size_t i = 0; i < len; ++i)
+        {
+            container_index->offsets.push_back(it - buffer_);
+            if (is_map)
+            {
+                if (*it == 0x7f)
+                {
+                    string_type key;
+                    std::tie(key, std::ignore) = detail::get_text_string(it, end);
+                    container_index->assembled_keys.push_back(std::move(key));
+                    const string_type& assembled = container_index->assembled_keys.back();
+                    container_index->keys.emplace_back(string_view_type(assembled.data(), assembled.length()), i);
+                }
+                else if (detail::is_string(*it))
+                {
+                    string_view_type key;
+                    std::tie(key, std::ignore) = detail::get_fixed_length_text_string_view(it, end);
+                    container_index->keys.emplace_back(key, i);
+                }
+                it = detail::walk(it, end);
+                container_index->offsets.push_back(it - buffer_);
+            }
+            it = detail::walk(it, end);
+        }
+        container_index->offsets.push_back(it - buffer_);
+
+        // Stable, so that of equal keys the first is found, as when walking
+        std::stable_sort(container_index->keys.begin(), container_index->keys.end(),
+                         [](const std::pair<string_view_type,size_t>& a, const std::pair<string_view_type,size_t>& b)
+                         {return a.first.compare(b.first) < 0;});
+        return container_index;
+    }
+
+    static bool find_key(const detail::cbor_container_index& container_index, const string_view_type& key, size_t& entry)
+    {
+        auto it = std::lower_bound(container_index.keys.begin(), container_index.keys.end(), key,
+                                   [](const std::pair<string_view_type,size_t>& a, const string_view_type& k)
+                                   {return a.first.compare(k) < 0;});
+        if (it == container_index.keys.end() || it->first != key)
+        {
+            return false;
+        }
+        entry = it->second;
+        return true;
+    }
+};
+
+// cbor_key_value
+
+class cbor_key_value
+{
+    cbor_view::string_view_type key_;
+    cbor_view value_;
+    // The key, if it was in chunks, put together
+    std::string buffer_;
+    bool assembled_;
+public:
+    cbor_key_value()
+        : assembled_(false)
+    {
+    }
+
+    cbor_key_value(const cbor_key_value& other)
+        : key_(other.key_), value_(other.value_), buffer_(other.buffer_), assembled_(other.assembled_)
+    {
+        if (assembled_)
+        {
+            key_ = cbor_view::string_view_type(buffer_.data(), buffer_.length());
+        }
+    }
+
+    cbor_key_value& operator=(const cbor_key_value& other)
+    {
+        if (this != &other)
+        {
+            value_ = other.value_;
+            buffer_ = other.buffer_;
+            assembled_ = other.assembled_;
+            key_ = assembled_ ? cbor_view::string_view_type(buffer_.data(), buffer_.length()) : other.key_;
+        }
+        return *this;
+    }
+
+    // A view of the key, in the cbor buffer unless the key was in chunks
+    cbor_view::string_view_type key() const
+    {
+        return key_;
+    }
+
+    const cbor_view& value() const
+    {
+        return value_;
+    }
+
+    friend class cbor_object_iterator;
+};
+
+// cbor_array_iterator
+
+// Visits the elements of a cbor array one walk at a time, without an index
+
+class cbor_array_iterator
+{
+    const uint8_t* end_;
+    size_t remaining_;
+    bool indefinite_;
+    cbor_view value_;
+public:
+    typedef cbor_view value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const cbor_view* pointer;
+    typedef const cbor_view& reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    cbor_array_iterator()
+        : end_(nullptr), remaining_(0), indefinite_(false)
+    {
+    }
+
+    cbor_array_iterator(const uint8_t* first, const uint8_t* end, size_t length, bool indefinite)
+        : end_(end), remaining_(length), indefinite_(indefinite)
+    {
+        settle(first);
+    }
+
+    const cbor_view& operator*() const
+    {
+        return value_;
+    }
+
+    const cbor_view* operator->() const
+    {
+        return &value_;
+    }
+
+    cbor_array_iterator& operator++()
+    {
+        if (!indefinite_)
+        {
+            --remaining_;
+        }
+        settle(value_.buffer() + value_.buflen());
+        return *this;
+    }
+
+    cbor_array_iterator operator++(int)
+    {
+        cbor_array_iterator temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    friend bool operator==(const cbor_array_iterator& lhs, const cbor_array_iterator& rhs)
+    {
+        return lhs.value_.buffer() == rhs.value_.buffer();
+    }
+
+    friend bool operator!=(const cbor_array_iterator& lhs, const cbor_array_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Finds the element that starts at it, or becomes the end iterator if there are no more
+    void settle(const uint8_t* it)
+    {
+        if (indefinite_ ? (it >= end_ || *it == 0xff) : remaining_ == 0)
+        {
+            value_ = cbor_view();
+        }
+        else
+        {
+            value_ = cbor_view(it, detail::walk(it, end_) - it);
+        }
+    }
 };
 
+// cbor_object_iterator
+
+// Visits the entries of a cbor map one walk at a time, without an index
+
+class cbor_object_iterator
+{
+    const uint8_t* end_;
+    size_t remaining_;
+    bool indefinite_;
+    cbor_key_value kv_;
+public:
+    typedef cbor_key_value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const cbor_key_value* pointer;
+    typedef const cbor_key_value& reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    cbor_object_iterator()
+        : end_(nullptr), remaining_(0), indefinite_(false)
+    {
+    }
+
+    cbor_object_iterator(const uint8_t* first, const uint8_t* end, size_t length, bool indefinite)
+        : end_(end), remaining_(length), indefinite_(indefinite)
+    {
+        settle(first);
+    }
+
+    const cbor_key_value& operator*() const
+    {
+        return kv_;
+    }
+
+    const cbor_key_value* operator->() const
+    {
+        return &kv_;
+    }
+
+    cbor_object_iterator& operator++()
+    {
+        if (!indefinite_)
+        {
+            --remaining_;
+        }
+        settle(kv_.value_.buffer() + kv_.value_.buflen());
+        return *this;
+    }
+
+    cbor_object_iterator operator++(int)
+    {
+        cbor_object_iterator temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    friend bool operator==(const cbor_object_iterator& lhs, const cbor_object_iterator& rhs)
+    {
+        return lhs.kv_.value().buffer() == rhs.kv_.value().buffer();
+    }
+
+    friend bool operator!=(const cbor_object_iterator& lhs, const cbor_object_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Reads the key and finds the value of the entry that starts at it, or becomes the end
+    // iterator if there are no more
+    void settle(const uint8_t* it)
+    {
+        if (indefinite_ ? (it >= end_ || *it == 0xff) : remaining_ == 0)
+        {
+            kv_.key_ = cbor_view::string_view_type();
+            kv_.value_ = cbor_view();
+            return;
+        }
+        const uint8_t* value;
+        kv_.assembled_ = *it == 0x7f;
+        std::tie(kv_.key_, value) = detail::get_text_string_view(it, end_, kv_.buffer_);
+        kv_.value_ = cbor_view(value, detail::walk(value, end_) - value);
+    }
+};
+
+inline
+range<cbor_view::const_array_iterator> cbor_view::array_range() const
+{
+    JSONCONS_ASSERT(is_array());
+    size_t len;
+    const uint8_t* it;
+    std::tie(len, it) = detail::size(buffer_,buffer_+buflen_);
+    return range<const_array_iterator>(const_array_iterator(it, buffer_+buflen_, len, buffer_[0] == 0x9f),
+                                       const_array_iterator());
+}
+
+inline
+range<cbor_view::const_object_iterator> cbor_view::object_range() const
+{
+    JSONCONS_ASSERT(is_object());
+    size_t len;
+    const uint8_t* it;
+    std::tie(len, it) = detail::size(buffer_,buffer_+buflen_);
+    return range<const_object_iterator>(const_object_iterator(it, buffer_+buflen_, len, buffer_[0] == 0xbf),
+                                        const_object_iterator());
+}
+
 struct Encode_cbor_
 {
     template <typename T>
@@ -1045,9 +1533,17 @@ struct cbor_Encoder_
                 }
 
                 // append each element
-                for (const auto& el : jval.array_range())
+                const auto& a = jval.array_value();
+                if (a.packing() != packed_kind::none)
+                {
+                    encode_packed(a, action, v);
+                }
+                else
                 {
-                    encode(el,action,v);
+                    for (const auto& el : a)
+                    {
+                        encode(el,action,v);
+                    }
                 }
                 break;
             }
@@ -1092,6 +1588,43 @@ struct cbor_Encoder_
         }
     }
 
+    template <class Action,class Result>
+    static void encode_packed(const typename Json::array& a, Action action, Result& v)
+    {
+        const size_t n = a.size();
+        switch (a.packing())
+        {
+        case packed_kind::integer:
+            {
+                const int64_t* p = a.template packed_data<int64_t>();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    encode(Json(p[i]), action, v);
+                }
+            }
+            break;
+        case packed_kind::uinteger:
+            {
+                const uint64_t* p = a.template packed_data<uint64_t>();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    encode(Json(p[i]), action, v);
+                }
+            }
+            break;
+        default:
+            {
+                const double* p = a.template packed_data<double>();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    action(static_cast<uint8_t>(0xfb), v);
+                    action(p[i],v);
+                }
+            }
+            break;
+        }
+    }
+
     template <class Action,class Result>
     static void encode_string(const string_view_type& sv, Action action, Result& v)
     {
@@ -1341,11 +1874,15 @@ public:
         case 0x9f:
             {
                 Json result = typename Json::array();
-                while (*pos != 0xff)
+                while (it_ < end_ && *it_ != 0xff)
                 {
                     result.push_back(decode());
-                    pos = it_;
                 }
+                if (it_ == end_)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                ++it_; // skip the break
                 return result;
             }
 
@@ -1391,15 +1928,31 @@ public:
         case 0xbf:
             {
                 Json result = typename Json::object();
-                while (*pos != 0xff)
+                while (it_ < end_ && *it_ != 0xff)
                 {
                     auto j = decode();
                     result.set(j.as_string_view(),decode());
-                    pos = it_;
                 }
+                if (it_ == end_)
+                {
+                    JSONCONS_THROW_EXCEPTION_OLD(std::invalid_argument,"eof");
+                }
+                ++it_; // skip the break
                 return result;
             }
 
+            // tag (one-byte uint8_t tag number follows)
+        case 0xd8:
+            {
+                const auto tag = binary::detail::from_big_endian<uint8_t>(it_,end_);
+                it_ += sizeof(uint8_t);
+                if (tag >= 0x40 && tag <= 0x57)
+                {
+                    return get_typed_array(tag);
+                }
+                JSONCONS_THROW_EXCEPTION_1(std::invalid_argument,"Error decoding a cbor at position %s", std::to_string(end_-pos));
+            }
+
             // False
         case 0xf4:
             {
@@ -1464,6 +2017,76 @@ public:
         return result;
     }
 
+    // A typed array (RFC 8746), tags 64 to 87, is a byte string of integers or floats. Tag bit 4
+    // is set for floats, bit 3 for signed integers and bit 2 for little endian, and the low two
+    // bits give the size. Arrays long enough are decoded packed.
+    Json get_typed_array(uint8_t tag)
+    {
+        const bool is_float = (tag & 0x10) != 0;
+        const bool is_signed = (tag & 0x08) != 0;
+        const bool is_little_endian = (tag & 0x04) != 0;
+        const size_t size = is_float ? (size_t(2) << (tag & 0x03)) : (size_t(1) << (tag & 0x03));
+        if (tag == 0x4c || size > sizeof(uint64_t))
+        {
+            JSONCONS_THROW_EXCEPTION_1(std::invalid_argument,"Unsupported cbor typed array tag %s", std::to_string(tag));
+        }
+
+        std::vector<uint8_t> bytes;
+        std::tie(bytes,it_) = detail::get_byte_string(it_,end_);
+        if (bytes.size() % size != 0)
+        {
+            JSONCONS_THROW_EXCEPTION_1(std::invalid_argument,"Error decoding a cbor typed array of length %s", std::to_string(bytes.size()));
+        }
+        const size_t n = bytes.size() / size;
+
+        Json result = typename Json::array();
+        if (is_float)
+        {
+            std::vector<double> values(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64_t x = detail::get_typed_array_element(bytes.data() + i*size, size, is_little_endian);
+                if (size == sizeof(uint16_t))
+                {
+                    values[i] = binary::detail::decode_half(static_cast<uint16_t>(x));
+                }
+                else if (size == sizeof(uint32_t))
+                {
+                    const uint32_t bits = static_cast<uint32_t>(x);
+                    float val;
+                    std::memcpy(&val, &bits, sizeof(val));
+                    values[i] = val;
+                }
+                else
+                {
+                    std::memcpy(&values[i], &x, sizeof(double));
+                }
+            }
+            result.array_value().assign_packed(values.begin(), values.end());
+        }
+        else if (is_signed)
+        {
+            const unsigned shift = static_cast<unsigned>(64 - 8*size);
+            std::vector<int64_t> values(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64_t x = detail::get_typed_array_element(bytes.data() + i*size, size, is_little_endian);
+                values[i] = static_cast<int64_t>(x << shift) >> shift;
+            }
+            result.array_value().assign_packed(values.begin(), values.end());
+        }
+        else
+        {
+            std::vector<uint64_t> values(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = detail::get_typed_array_element(bytes.data() + i*size, size, is_little_endian);
+            }
+            result.array_value().assign_packed(values.begin(), values.end());
+        }
+        return result;
+    }
+
     template<typename T>
     Json get_fixed_length_map(const T len)
     {
@@ -1481,11 +2104,15 @@ public:
 template<class Json>
 void encode_cbor(const Json& j, std::vector<uint8_t>& v)
 {
-    size_t n = 0;
-    cbor_Encoder_<Json>::encode(j,Calculate_size_(),n);
+    basic_cbor_serializer<typename Json::char_type> serializer(v);
+    j.dump(serializer);
+}
 
-    v.reserve(n);
-    cbor_Encoder_<Json>::encode(j,Encode_cbor_(),v);
+template<class Json>
+void encode_cbor(const Json& j, std::ostream& os)
+{
+    basic_cbor_serializer<typename Json::char_type> serializer(os);
+    j.dump(serializer);
 }
 
 template<class Json>
@@ -1494,6 +2121,12 @@ Json decode_cbor(const cbor_view& v)
     Decode_cbor_<Json> decoder(v.buffer(),v.buffer()+v.buflen());
     return decoder.decode();
 }
+
+template <class Json>
+Json cbor_view::as() const
+{
+    return decode_cbor<Json>(*this);
+}
   
 #if !defined(JSONCONS_NO_DEPRECATED)
 template<class Json>
@@ -0,0 +1,87 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_ERROR_CATEGORY_HPP
+#define JSONCONS_CBOR_CBOR_ERROR_CATEGORY_HPP
+
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+
+namespace jsoncons { namespace cbor {
+
+    enum class cbor_parser_errc : int
+    {
+        ok = 0,
+        unexpected_eof = 1,
+        source_error = 2,
+        invalid_initial_byte = 3,
+        unexpected_break = 4,
+        expected_text_string_key = 5,
+        invalid_string_chunk = 6,
+        invalid_utf8_text_string = 7,
+        length_too_large = 8,
+        invalid_typed_array = 9
+    };
+
+class cbor_error_category_impl
+   : public std::error_category
+{
+public:
+    virtual const char* name() const JSONCONS_NOEXCEPT
+    {
+        return "cbor";
+    }
+    virtual std::string message(int ev) const
+    {
+        switch (static_cast<cbor_parser_errc>(ev))
+        {
+        case cbor_parser_errc::unexpected_eof:
+            return "Unexpected end of file";
+        case cbor_parser_errc::source_error:
+            return "Source error";
+        case cbor_parser_errc::invalid_initial_byte:
+            return "Invalid initial byte of a cbor data item";
+        case cbor_parser_errc::unexpected_break:
+            return "Break outside an indefinite length item";
+        case cbor_parser_errc::expected_text_string_key:
+            return "Expected a text string as map key";
+        case cbor_parser_errc::invalid_string_chunk:
+            return "Indefinite length string chunk of the wrong type";
+        case cbor_parser_errc::invalid_utf8_text_string:
+            return "Illegal UTF-8 in text string";
+        case cbor_parser_errc::length_too_large:
+            return "String length too large";
+        case cbor_parser_errc::invalid_typed_array:
+            return "Unsupported or malformed typed array";
+        default:
+            return "Unknown CBOR parser error";
+        }
+    }
+};
+
+inline
+const std::error_category& cbor_error_category()
+{
+  static cbor_error_category_impl instance;
+  return instance;
+}
+
+inline
+std::error_code make_error_code(cbor_parser_errc result)
+{
+    return std::error_code(static_cast<int>(result),cbor_error_category());
+}
+
+}}
+
+namespace std {
+    template<>
+    struct is_error_code_enum<jsoncons::cbor::cbor_parser_errc> : public true_type
+    {
+    };
+}
+
+#endif
@@ -0,0 +1,564 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_PARSER_HPP
+#define JSONCONS_CBOR_CBOR_PARSER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/detail/unicode_traits.hpp>
+#include <jsoncons_ext/binary/binary_utilities.hpp>
+#include <jsoncons_ext/cbor/cbor_error_category.hpp>
+
+namespace jsoncons { namespace cbor {
+
+namespace detail {
+
+    // Reads element size bytes at p of a typed array (RFC 8746)
+    inline
+    uint64_t get_typed_array_element(const uint8_t* p, size_t size, bool is_little_endian)
+    {
+        uint64_t x = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            x = (x << 8) | p[is_little_endian ? size - 1 - i : i];
+        }
+        return x;
+    }
+}
+
+// basic_cbor_parser
+
+// Reports the cbor data items in the bytes it is given as events to a basic_json_input_handler.
+// Input may arrive in chunks of any size: an item cut off at the end of one chunk is set aside
+// and completed from the next. Only the item being read is kept, a string at most, and arrays
+// and maps are tracked on a stack, so memory use does not grow with the size of the document.
+
+template<class CharT>
+class basic_cbor_parser : private parsing_context
+{
+    typedef CharT char_type;
+    typedef basic_string_view_ext<CharT> string_view_type;
+
+    enum class parse_mode {array, map, text_string, byte_string};
+
+    struct stack_item
+    {
+        stack_item(parse_mode mode, bool indefinite, uint64_t length, uint64_t tag)
+           : mode_(mode), indefinite_(indefinite), length_(length), index_(0), tag_(tag)
+        {
+        }
+
+        parse_mode mode_;
+        bool indefinite_;
+        uint64_t length_;
+        uint64_t index_;
+        uint64_t tag_;
+    };
+
+    basic_json_input_handler<CharT>& handler_;
+    std::vector<stack_item> stack_;
+    std::vector<uint8_t> carry_;
+    std::vector<uint8_t> bytes_;
+    std::basic_string<CharT> text_;
+    const uint8_t* input_ptr_;
+    const uint8_t* input_end_;
+    size_t position_;
+    size_t item_position_;
+    uint64_t tag_;
+    bool begun_;
+    bool done_;
+
+    // Noncopyable and nonmoveable
+    basic_cbor_parser(const basic_cbor_parser&) = delete;
+    basic_cbor_parser& operator=(const basic_cbor_parser&) = delete;
+
+public:
+    basic_cbor_parser(basic_json_input_handler<CharT>& handler)
+       : handler_(handler),
+         input_ptr_(nullptr),
+         input_end_(nullptr),
+         position_(0),
+         item_position_(0),
+         tag_(0),
+         begun_(false),
+         done_(false)
+    {
+    }
+
+    // Ready to read the next data item
+    void reset()
+    {
+        stack_.clear();
+        carry_.clear();
+        tag_ = 0;
+        begun_ = false;
+        done_ = false;
+    }
+
+    // Sets the next chunk of input, which must stay valid until it has been parsed
+    void update(const uint8_t* data, size_t length)
+    {
+        input_ptr_ = data;
+        input_end_ = data + length;
+    }
+
+    bool done() const
+    {
+        return done_;
+    }
+
+    bool source_exhausted() const
+    {
+        return input_ptr_ == input_end_;
+    }
+
+    // Number of bytes read so far
+    size_t position() const
+    {
+        return position_;
+    }
+
+    // Parses until the current data item is complete or the input runs out
+    void parse_some(std::error_code& ec)
+    {
+        while (!done_)
+        {
+            if (!stack_.empty())
+            {
+                const stack_item& top = stack_.back();
+                if (!top.indefinite_ && top.index_ == top.length_)
+                {
+                    end_container(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+            }
+
+            const uint8_t* item;
+            size_t length;
+            if (!carry_.empty())
+            {
+                if (!complete_carry(ec))
+                {
+                    return;
+                }
+                item = carry_.data();
+                length = carry_.size();
+            }
+            else
+            {
+                if (input_ptr_ == input_end_)
+                {
+                    return;
+                }
+                const size_t available = input_end_ - input_ptr_;
+                length = item_length(input_ptr_, available, ec);
+                if (ec)
+                {
+                    return;
+                }
+                item_position_ = position_;
+                if (length > available)
+                {
+                    carry_.assign(input_ptr_, input_end_);
+                    position_ += available;
+                    input_ptr_ = input_end_;
+                    continue;
+                }
+                item = input_ptr_;
+                input_ptr_ += length;
+                position_ += length;
+            }
+            parse_item(item, length, ec);
+            carry_.clear();
+            if (ec)
+            {
+                return;
+            }
+        }
+    }
+
+    // Called once there is no more input
+    void end_parse(std::error_code& ec)
+    {
+        if (!done_)
+        {
+            ec = cbor_parser_errc::unexpected_eof;
+        }
+    }
+
+private:
+    size_t do_line_number() const override
+    {
+        return 1;
+    }
+
+    size_t do_column_number() const override
+    {
+        return item_position_ + 1;
+    }
+
+    // Returns the length of the item that starts at p, the header alone for an array, map or tag,
+    // or, if the n bytes available are not enough to tell, the number needed to tell
+    static size_t item_length(const uint8_t* p, size_t n, std::error_code& ec)
+    {
+        if (n == 0)
+        {
+            return 1;
+        }
+        const uint8_t major_type = p[0] >> 5;
+        const uint8_t info = p[0] & 0x1f;
+        const size_t header = header_length(info);
+        if ((major_type == 2 || major_type == 3) && info != 31)
+        {
+            if (n < header)
+            {
+                return header;
+            }
+            const uint64_t length = get_argument(p, header);
+            if (length > (std::numeric_limits<size_t>::max)() - header)
+            {
+                ec = cbor_parser_errc::length_too_large;
+                return 0;
+            }
+            return header + static_cast<size_t>(length);
+        }
+        return header;
+    }
+
+    // Adds bytes from the input to the partial item set aside until it is complete
+    bool complete_carry(std::error_code& ec)
+    {
+        while (true)
+        {
+            const size_t needed = item_length(carry_.data(), carry_.size(), ec);
+            if (ec)
+            {
+                return false;
+            }
+            if (needed <= carry_.size())
+            {
+                return true;
+            }
+            if (input_ptr_ == input_end_)
+            {
+                return false;
+            }
+            const size_t n = (std::min)(needed - carry_.size(), static_cast<size_t>(input_end_ - input_ptr_));
+            carry_.insert(carry_.end(), input_ptr_, input_ptr_ + n);
+            input_ptr_ += n;
+            position_ += n;
+        }
+    }
+
+    static uint64_t get_argument(const uint8_t* p, size_t header)
+    {
+        switch (header)
+        {
+        case 1 + sizeof(uint8_t):
+            return binary::detail::from_big_endian<uint8_t>(p + 1, p + header);
+        case 1 + sizeof(uint16_t):
+            return binary::detail::from_big_endian<uint16_t>(p + 1, p + header);
+        case 1 + sizeof(uint32_t):
+            return binary::detail::from_big_endian<uint32_t>(p + 1, p + header);
+        case 1 + sizeof(uint64_t):
+            return binary::detail::from_big_endian<uint64_t>(p + 1, p + header);
+        default:
+            return p[0] & 0x1f;
+        }
+    }
+
+    void parse_item(const uint8_t* p, size_t length, std::error_code& ec)
+    {
+        const uint8_t major_type = p[0] >> 5;
+        const uint8_t info = p[0] & 0x1f;
+        const size_t header = header_length(info);
+
+        const uint64_t tag = tag_;
+        tag_ = 0;
+
+        if (p[0] == 0xff)
+        {
+            if (stack_.empty() || !stack_.back().indefinite_)
+            {
+                ec = cbor_parser_errc::unexpected_break;
+                return;
+            }
+            end_container(ec);
+            return;
+        }
+
+        if (!stack_.empty())
+        {
+            const stack_item& top = stack_.back();
+            if (top.mode_ == parse_mode::text_string || top.mode_ == parse_mode::byte_string)
+            {
+                const uint8_t chunk_type = top.mode_ == parse_mode::text_string ? 3 : 2;
+                if (major_type != chunk_type || info == 31 || info > 27)
+                {
+                    ec = cbor_parser_errc::invalid_string_chunk;
+                    return;
+                }
+                bytes_.insert(bytes_.end(), p + header, p + length);
+                return;
+            }
+            if (top.mode_ == parse_mode::map && top.index_ % 2 == 0 && major_type != 3 && major_type != 6)
+            {
+                ec = cbor_parser_errc::expected_text_string_key;
+                return;
+            }
+        }
+        else if (!begun_)
+        {
+            handler_.begin_json();
+            begun_ = true;
+        }
+
+        if (info > 27 && (info != 31 || major_type < 2 || major_type == 6))
+        {
+            ec = cbor_parser_errc::invalid_initial_byte;
+            return;
+        }
+
+        switch (major_type)
+        {
+        case 0: // Unsigned integer
+            handler_.uinteger_value(get_argument(p, header), *this);
+            break;
+        case 1: // Negative integer -1-n
+            handler_.integer_value(static_cast<int64_t>(-1) - static_cast<int64_t>(get_argument(p, header)), *this);
+            break;
+        case 2: // byte string
+            if (info == 31)
+            {
+                bytes_.clear();
+                stack_.push_back(stack_item(parse_mode::byte_string, true, 0, tag));
+                return;
+            }
+            if (tag != 0)
+            {
+                typed_array_value(tag, p + header, length - header, ec);
+                if (ec) return;
+            }
+            else
+            {
+                handler_.byte_string_value(p + header, length - header, *this);
+            }
+            break;
+        case 3: // UTF-8 string
+            if (info == 31)
+            {
+                bytes_.clear();
+                stack_.push_back(stack_item(parse_mode::text_string, true, 0, 0));
+                return;
+            }
+            text_string_value(p + header, length - header, ec);
+            if (ec) return;
+            break;
+        case 4: // array
+            handler_.begin_array(*this);
+            stack_.push_back(stack_item(parse_mode::array, info == 31, info == 31 ? 0 : get_argument(p, header), 0));
+            return;
+        case 5: // map
+            handler_.begin_object(*this);
+            stack_.push_back(stack_item(parse_mode::map, info == 31, info == 31 ? 0 : 2*get_argument(p, header), 0));
+            return;
+        case 6: // tag, only typed arrays are given a meaning, the tagged item follows
+            {
+                const uint64_t n = get_argument(p, header);
+                tag_ = n >= 0x40 && n <= 0x57 ? n : 0;
+            }
+            return;
+        default: // floats and simple values
+            switch (info)
+            {
+            case 20:
+                handler_.bool_value(false, *this);
+                break;
+            case 21:
+                handler_.bool_value(true, *this);
+                break;
+            case 22:
+            case 23:
+                handler_.null_value(*this);
+                break;
+            case 25:
+                handler_.double_value(binary::detail::decode_half(binary::detail::from_big_endian<uint16_t>(p + 1, p + length)), *this);
+                break;
+            case 26:
+                handler_.double_value(binary::detail::from_big_endian<float>(p + 1, p + length), *this);
+                break;
+            case 27:
+                handler_.double_value(binary::detail::from_big_endian<double>(p + 1, p + length), *this);
+                break;
+            default:
+                ec = cbor_parser_errc::invalid_initial_byte;
+                return;
+            }
+            break;
+        }
+        end_item();
+    }
+
+    static size_t header_length(uint8_t info)
+    {
+        switch (info)
+        {
+        case 24:
+            return 1 + sizeof(uint8_t);
+        case 25:
+            return 1 + sizeof(uint16_t);
+        case 26:
+            return 1 + sizeof(uint32_t);
+        case 27:
+            return 1 + sizeof(uint64_t);
+        default:
+            return 1;
+        }
+    }
+
+    // Ends the array, map or indefinite length string on top of the stack
+    void end_container(std::error_code& ec)
+    {
+        const stack_item item = stack_.back();
+        stack_.pop_back();
+        switch (item.mode_)
+        {
+        case parse_mode::array:
+            handler_.end_array(*this);
+            break;
+        case parse_mode::map:
+            handler_.end_object(*this);
+            break;
+        case parse_mode::text_string:
+            text_string_value(bytes_.data(), bytes_.size(), ec);
+            if (ec) return;
+            break;
+        case parse_mode::byte_string:
+            if (item.tag_ != 0)
+            {
+                typed_array_value(item.tag_, bytes_.data(), bytes_.size(), ec);
+                if (ec) return;
+            }
+            else
+            {
+                handler_.byte_string_value(bytes_.data(), bytes_.size(), *this);
+            }
+            break;
+        }
+        end_item();
+    }
+
+    void end_item()
+    {
+        if (!stack_.empty())
+        {
+            ++stack_.back().index_;
+        }
+        else
+        {
+            handler_.end_json();
+            done_ = true;
+        }
+    }
+
+    bool is_key() const
+    {
+        return !stack_.empty() && stack_.back().mode_ == parse_mode::map && stack_.back().index_ % 2 == 0;
+    }
+
+    void text_string_value(const uint8_t* data, size_t length, std::error_code& ec)
+    {
+        text_.clear();
+        const char* first = reinterpret_cast<const char*>(data);
+        auto result = unicons::convert(first, first + length,
+                                       std::back_inserter(text_),
+                                       unicons::conv_flags::strict);
+        if (result.ec != unicons::conv_errc())
+        {
+            ec = cbor_parser_errc::invalid_utf8_text_string;
+            return;
+        }
+        if (is_key())
+        {
+            handler_.name(string_view_type(text_.data(), text_.length()), *this);
+        }
+        else
+        {
+            handler_.string_value(string_view_type(text_.data(), text_.length()), *this);
+        }
+    }
+
+    // A typed array (RFC 8746), tags 64 to 87, is a byte string of integers or floats. Tag bit 4
+    // is set for floats, bit 3 for signed integers and bit 2 for little endian, and the low two
+    // bits give the size. It is reported as an array.
+    void typed_array_value(uint64_t tag, const uint8_t* data, size_t length, std::error_code& ec)
+    {
+        const bool is_float = (tag & 0x10) != 0;
+        const bool is_signed = (tag & 0x08) != 0;
+        const bool is_little_endian = (tag & 0x04) != 0;
+        const size_t size = is_float ? (size_t(2) << (tag & 0x03)) : (size_t(1) << (tag & 0x03));
+        if (tag == 0x4c || size > sizeof(uint64_t) || length % size != 0)
+        {
+            ec = cbor_parser_errc::invalid_typed_array;
+            return;
+        }
+
+        handler_.begin_array(*this);
+        const unsigned shift = static_cast<unsigned>(64 - 8*size);
+        for (const uint8_t* p = data; p != data + length; p += size)
+        {
+            const uint64_t x = detail::get_typed_array_element(p, size, is_little_endian);
+            if (is_float)
+            {
+                if (size == sizeof(uint16_t))
+                {
+                    handler_.double_value(binary::detail::decode_half(static_cast<uint16_t>(x)), *this);
+                }
+                else if (size == sizeof(uint32_t))
+                {
+                    const uint32_t bits = static_cast<uint32_t>(x);
+                    float val;
+                    std::memcpy(&val, &bits, sizeof(val));
+                    handler_.double_value(val, *this);
+                }
+                else
+                {
+                    double val;
+                    std::memcpy(&val, &x, sizeof(val));
+                    handler_.double_value(val, *this);
+                }
+            }
+            else if (is_signed)
+            {
+                handler_.integer_value(static_cast<int64_t>(x << shift) >> shift, *this);
+            }
+            else
+            {
+                handler_.uinteger_value(x, *this);
+            }
+        }
+        handler_.end_array(*this);
+    }
+};
+
+typedef basic_cbor_parser<char> cbor_parser;
+typedef basic_cbor_parser<wchar_t> wcbor_parser;
+
+}}
+
+#endif
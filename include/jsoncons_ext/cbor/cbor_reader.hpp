@@ -0,0 +1,139 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_READER_HPP
+#define JSONCONS_CBOR_CBOR_READER_HPP
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <system_error>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons_ext/cbor/cbor_error_category.hpp>
+#include <jsoncons_ext/cbor/cbor_parser.hpp>
+
+namespace jsoncons { namespace cbor {
+
+// basic_cbor_reader
+
+// Reads cbor from a std::istream in blocks of buffer_length() bytes and reports it to a
+// basic_json_input_handler, for example a json_decoder, or a json_serializer through a
+// json_filter. Each call to read() reads one data item, so a stream of items written one after
+// another can be read in turn until eof(), which is true once the last item has been read. A
+// read() at the end of the stream reports nothing and succeeds; one that ends partway through an
+// item fails with unexpected_eof.
+
+template<class CharT>
+class basic_cbor_reader
+{
+    static const size_t default_max_buffer_length = 16384;
+
+    basic_cbor_parser<CharT> parser_;
+    std::istream& is_;
+    std::vector<uint8_t> buffer_;
+    size_t buffer_length_;
+    bool eof_;
+
+    // Noncopyable and nonmoveable
+    basic_cbor_reader(const basic_cbor_reader&) = delete;
+    basic_cbor_reader& operator=(const basic_cbor_reader&) = delete;
+
+public:
+    basic_cbor_reader(std::istream& is, basic_json_input_handler<CharT>& handler)
+       : parser_(handler),
+         is_(is),
+         buffer_length_(default_max_buffer_length),
+         eof_(false)
+    {
+    }
+
+    size_t buffer_length() const
+    {
+        return buffer_length_;
+    }
+
+    void buffer_length(size_t length)
+    {
+        buffer_length_ = length;
+    }
+
+    // True once there is no more input after the last item read
+    bool eof() const
+    {
+        return eof_;
+    }
+
+    void read()
+    {
+        std::error_code ec;
+        read(ec);
+        if (ec)
+        {
+            throw parse_error(ec,1,parser_.position()+1);
+        }
+    }
+
+    void read(std::error_code& ec)
+    {
+        parser_.reset();
+        const size_t start = parser_.position();
+        while (!parser_.done())
+        {
+            if (parser_.source_exhausted())
+            {
+                read_buffer(ec);
+                if (ec) return;
+                if (eof_)
+                {
+                    // Nothing of a new item is a clean end, not a truncated one
+                    if (parser_.position() != start)
+                    {
+                        parser_.end_parse(ec);
+                    }
+                    return;
+                }
+            }
+            parser_.parse_some(ec);
+            if (ec) return;
+        }
+        if (parser_.source_exhausted() && is_.peek() == std::char_traits<char>::eof())
+        {
+            eof_ = true;
+        }
+    }
+
+private:
+    void read_buffer(std::error_code& ec)
+    {
+        if (is_.eof())
+        {
+            eof_ = true;
+            return;
+        }
+        if (is_.fail())
+        {
+            ec = cbor_parser_errc::source_error;
+            return;
+        }
+        buffer_.resize(buffer_length_);
+        is_.read(reinterpret_cast<char*>(buffer_.data()), buffer_length_);
+        buffer_.resize(static_cast<size_t>(is_.gcount()));
+        if (buffer_.empty())
+        {
+            eof_ = true;
+            return;
+        }
+        parser_.update(buffer_.data(), buffer_.size());
+    }
+};
+
+typedef basic_cbor_reader<char> cbor_reader;
+typedef basic_cbor_reader<wchar_t> wcbor_reader;
+
+}}
+
+#endif
@@ -0,0 +1,320 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_SERIALIZER_HPP
+#define JSONCONS_CBOR_CBOR_SERIALIZER_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdlib>
+#include <limits> // std::numeric_limits
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_output_handler.hpp>
+#include <jsoncons/detail/unicode_traits.hpp>
+#include <jsoncons_ext/binary/binary_utilities.hpp>
+
+namespace jsoncons { namespace cbor {
+
+// basic_cbor_serializer
+
+// Writes the events it receives as cbor as they arrive. Written to a std::vector<uint8_t>,
+// arrays and maps get definite lengths, as encode_cbor gives them. The header of each is
+// patched when it ends, and widened in place if the count needs more than the initial byte.
+// Written to a std::ostream, which cannot be patched, arrays and maps have indefinite length,
+// and the output is passed on in blocks, so memory use does not grow with the input.
+
+template<class CharT>
+class basic_cbor_serializer : public basic_json_output_handler<CharT>
+{
+public:
+    using typename basic_json_output_handler<CharT>::string_view_type;
+private:
+    static const size_t default_buffer_length = 16384;
+
+    struct stack_item
+    {
+        stack_item(bool is_object, size_t offset)
+           : is_object_(is_object), offset_(offset), count_(0)
+        {
+        }
+        bool is_object() const
+        {
+            return is_object_;
+        }
+
+        bool is_object_;
+        size_t offset_;
+        size_t count_;
+    };
+    std::ostream* os_;
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t>& v_;
+    std::vector<stack_item> stack_;
+    std::basic_string<uint8_t> utf8_;
+
+    // Noncopyable and nonmoveable
+    basic_cbor_serializer(const basic_cbor_serializer&) = delete;
+    basic_cbor_serializer& operator=(const basic_cbor_serializer&) = delete;
+public:
+    basic_cbor_serializer(std::vector<uint8_t>& v)
+       : os_(nullptr), v_(v)
+    {
+    }
+
+    basic_cbor_serializer(std::ostream& os)
+       : os_(&os), v_(buffer_)
+    {
+        buffer_.reserve(default_buffer_length);
+    }
+
+    ~basic_cbor_serializer()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+private:
+    void do_begin_json() override
+    {
+    }
+
+    void do_end_json() override
+    {
+        flush();
+        if (os_ != nullptr)
+        {
+            os_->flush();
+        }
+    }
+
+    void do_begin_object() override
+    {
+        begin_container(0xa0, 0xbf);
+    }
+
+    void do_end_object() override
+    {
+        end_container(0xa0);
+    }
+
+    void do_begin_array() override
+    {
+        begin_container(0x80, 0x9f);
+    }
+
+    void do_end_array() override
+    {
+        end_container(0x80);
+    }
+
+    void do_name(const string_view_type& name) override
+    {
+        write_string(name);
+    }
+
+    void do_null_value() override
+    {
+        begin_item();
+        binary::detail::to_big_endian(static_cast<uint8_t>(0xf6), v_);
+        end_item();
+    }
+
+    void do_string_value(const string_view_type& value) override
+    {
+        write_string(value);
+    }
+
+    void do_byte_string_value(const uint8_t* data, size_t length) override
+    {
+        begin_item();
+        write_header(0x40, length);
+        v_.insert(v_.end(), data, data+length);
+        end_item();
+    }
+
+    void do_double_value(double value, const number_format&) override
+    {
+        begin_item();
+        binary::detail::to_big_endian(static_cast<uint8_t>(0xfb), v_);
+        binary::detail::to_big_endian(value, v_);
+        end_item();
+    }
+
+    void do_integer_value(int64_t value) override
+    {
+        begin_item();
+        if (value >= 0)
+        {
+            write_header(0x00, static_cast<uint64_t>(value));
+        }
+        else
+        {
+            write_header(0x20, static_cast<uint64_t>(-1 - value));
+        }
+        end_item();
+    }
+
+    void do_uinteger_value(uint64_t value) override
+    {
+        begin_item();
+        write_header(0x00, value);
+        end_item();
+    }
+
+    void do_bool_value(bool value) override
+    {
+        begin_item();
+        binary::detail::to_big_endian(static_cast<uint8_t>(value ? 0xf5 : 0xf4), v_);
+        end_item();
+    }
+
+    void begin_container(uint8_t major_type, uint8_t indefinite_length)
+    {
+        begin_item();
+        stack_.push_back(stack_item(major_type == 0xa0, v_.size()));
+        // A one byte header, for now, if the length is patched in later
+        binary::detail::to_big_endian(static_cast<uint8_t>(os_ != nullptr ? indefinite_length : major_type), v_);
+    }
+
+    void end_container(uint8_t major_type)
+    {
+        JSONCONS_ASSERT(!stack_.empty());
+        const stack_item& item = stack_.back();
+        if (os_ != nullptr)
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(0xff), v_);
+        }
+        else
+        {
+            patch_header(major_type, item.offset_, item.is_object() ? item.count_/2 : item.count_);
+        }
+        stack_.pop_back();
+        end_item();
+    }
+
+    void write_string(const string_view_type& sv)
+    {
+        begin_item();
+        utf8_.clear();
+        auto result = unicons::convert(
+            sv.begin(), sv.end(), std::back_inserter(utf8_),
+            unicons::conv_flags::strict);
+        if (result.ec != unicons::conv_errc())
+        {
+            JSONCONS_THROW_EXCEPTION_OLD(std::runtime_error,"Illegal unicode");
+        }
+        write_header(0x60, utf8_.length());
+        v_.insert(v_.end(), utf8_.begin(), utf8_.end());
+        end_item();
+    }
+
+    // Writes the initial byte for major_type and length, and the length if it does not fit in it
+    void write_header(uint8_t major_type, uint64_t length)
+    {
+        if (length <= 0x17)
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(major_type + length), v_);
+        }
+        else if (length <= (std::numeric_limits<uint8_t>::max)())
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(major_type + 0x18), v_);
+            binary::detail::to_big_endian(static_cast<uint8_t>(length), v_);
+        }
+        else if (length <= (std::numeric_limits<uint16_t>::max)())
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(major_type + 0x19), v_);
+            binary::detail::to_big_endian(static_cast<uint16_t>(length), v_);
+        }
+        else if (length <= (std::numeric_limits<uint32_t>::max)())
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(major_type + 0x1a), v_);
+            binary::detail::to_big_endian(static_cast<uint32_t>(length), v_);
+        }
+        else
+        {
+            binary::detail::to_big_endian(static_cast<uint8_t>(major_type + 0x1b), v_);
+            binary::detail::to_big_endian(static_cast<uint64_t>(length), v_);
+        }
+    }
+
+    // Replaces the one byte header at offset with the header for length, moving what follows
+    // it along if the length needs bytes of its own
+    void patch_header(uint8_t major_type, size_t offset, uint64_t length)
+    {
+        if (length <= 0x17)
+        {
+            v_[offset] = static_cast<uint8_t>(major_type + length);
+            return;
+        }
+        size_t extra;
+        uint8_t additional;
+        if (length <= (std::numeric_limits<uint8_t>::max)())
+        {
+            extra = sizeof(uint8_t);
+            additional = 0x18;
+        }
+        else if (length <= (std::numeric_limits<uint16_t>::max)())
+        {
+            extra = sizeof(uint16_t);
+            additional = 0x19;
+        }
+        else if (length <= (std::numeric_limits<uint32_t>::max)())
+        {
+            extra = sizeof(uint32_t);
+            additional = 0x1a;
+        }
+        else
+        {
+            extra = sizeof(uint64_t);
+            additional = 0x1b;
+        }
+        v_.insert(v_.begin() + (offset + 1), extra, 0);
+        v_[offset] = static_cast<uint8_t>(major_type + additional);
+        for (size_t i = extra; i > 0; --i)
+        {
+            v_[offset + i] = static_cast<uint8_t>(length & 0xff);
+            length >>= 8;
+        }
+    }
+
+    void begin_item()
+    {
+        if (!stack_.empty())
+        {
+            ++stack_.back().count_;
+        }
+    }
+
+    void end_item()
+    {
+        if (os_ != nullptr && v_.size() >= default_buffer_length)
+        {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (os_ != nullptr && !v_.empty())
+        {
+            os_->write(reinterpret_cast<const char*>(v_.data()), v_.size());
+            v_.clear();
+        }
+    }
+};
+
+typedef basic_cbor_serializer<char> cbor_serializer;
+typedef basic_cbor_serializer<wchar_t> wcbor_serializer;
+
+}}
+
+#endif
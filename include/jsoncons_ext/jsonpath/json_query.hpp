@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <memory>
 #include <jsoncons/json.hpp>
+#include <jsoncons/detail/json_wrapper.hpp>
 #include "jsonpath_filter.hpp"
 #include "jsonpath_error_category.hpp"
 
@@ -21,8 +22,11 @@ namespace jsoncons { namespace jsonpath {
 
 enum class result_type {value,path};
 
+// Json may also be a view of an encoded value, such as a cbor_view. The query then reads only the
+// parts of the encoding on its way to the values it selects, and decodes just those into the
+// result, and the candidates of any filter expressions into Json::json_type to test them.
 template<class Json>
-Json json_query(const Json& root, const typename Json::string_view_type& path, result_type result_t = result_type::value)
+typename Json::json_type json_query(const Json& root, const typename Json::string_view_type& path, result_type result_t = result_type::value)
 {
     if (result_t == result_type::value)
     {
@@ -48,6 +52,9 @@ void json_replace(Json& root, const typename Json::string_view_type& path, T&& n
 
 namespace detail {
 
+using jsoncons::detail::json_wrapper;
+using jsoncons::detail::is_json_view;
+
 template<class CharT>
 bool try_string_to_index(const CharT *s, size_t length, size_t* value, bool* positive)
 {
@@ -134,27 +141,33 @@ private:
     typedef typename Json::char_type char_type;
     typedef typename Json::char_traits_type char_traits_type;
     typedef std::basic_string<char_type,char_traits_type> string_type;
-    typedef typename Json::key_storage_type key_storage_type;
     typedef typename Json::string_view_type string_view_type;
+    typedef typename Json::json_type json_type;
     typedef JsonReference reference;
-    using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
     struct node_type
     {
-        node_type() = default;
-        node_type(const string_type& p, const pointer& valp)
-            : skip_contained_object(false),path(p),val_ptr(valp)
+        node_type(const string_type& p, reference valref)
+            : skip_contained_object(false),path(p),val(valref),computed(nullptr)
+        {
+        }
+        node_type(string_type&& p, reference valref)
+            : skip_contained_object(false),path(std::move(p)),val(valref),computed(nullptr)
         {
         }
-        node_type(string_type&& p, pointer&& valp)
-            : skip_contained_object(false),path(std::move(p)),val_ptr(valp)
+        node_type(string_type&& p, reference valref, const json_type* computedp)
+            : skip_contained_object(false),path(std::move(p)),val(valref),computed(computedp)
         {
         }
         node_type(const node_type&) = default;
         node_type(node_type&&) = default;
+        node_type& operator=(const node_type&) = default;
+        node_type& operator=(node_type&&) = default;
 
         bool skip_contained_object;
         string_type path;
-        pointer val_ptr;
+        json_wrapper<Json,JsonReference> val;
+        // A value computed from a view, a length or a character of a string, that val cannot hold
+        const json_type* computed;
     };
     typedef std::vector<node_type> node_set;
 
@@ -164,6 +177,42 @@ private:
         return string_view_type{data,sizeof(data)/sizeof(char_type)};
     }
 
+    // The value as a json_type, to test against filters and to return: a Json value itself,
+    // a view decoded
+    static const json_type& to_json(const json_type& val, std::false_type)
+    {
+        return val;
+    }
+
+    static json_type to_json(const Json& val, std::true_type)
+    {
+        return val.template as<json_type>();
+    }
+
+    static auto to_json(const Json& val) -> decltype(to_json(val, is_json_view<Json>()))
+    {
+        return to_json(val, is_json_view<Json>());
+    }
+
+    // Adds a value computed from val, a length or a character of a string, to nodes. A node
+    // holds it as it would a selected value, unless Json is a view, which cannot.
+    static void add_computed(node_set& nodes, string_type&& path, std::shared_ptr<json_type> temp,
+                             std::vector<std::shared_ptr<json_type>>& temp_json_values)
+    {
+        temp_json_values.push_back(temp);
+        add_computed(nodes, std::move(path), *temp, is_json_view<Json>());
+    }
+
+    static void add_computed(node_set& nodes, string_type&& path, json_type& temp, std::false_type)
+    {
+        nodes.emplace_back(std::move(path), temp);
+    }
+
+    static void add_computed(node_set& nodes, string_type&& path, json_type& temp, std::true_type)
+    {
+        nodes.emplace_back(std::move(path), Json(), &temp);
+    }
+
     class selector
     {
     public:
@@ -171,29 +220,29 @@ private:
         {
         }
         virtual void select(node_type& node, const string_type& path, reference val,
-                            node_set& nodes, std::vector<std::shared_ptr<Json>>& temp_json_values) = 0;
+                            node_set& nodes, std::vector<std::shared_ptr<json_type>>& temp_json_values) = 0;
     };
 
     class expr_selector : public selector
     {
     private:
-         jsonpath_filter_expr<Json> result_;
+         jsonpath_filter_expr<json_type> result_;
     public:
-        expr_selector(const jsonpath_filter_expr<Json>& result)
+        expr_selector(const jsonpath_filter_expr<json_type>& result)
             : result_(result)
         {
         }
 
         void select(node_type& node, const string_type& path, reference val, 
-                    node_set& nodes, std::vector<std::shared_ptr<Json>>& temp_json_values) override
+                    node_set& nodes, std::vector<std::shared_ptr<json_type>>& temp_json_values) override
         {
-            auto index = result_.eval(val);
+            auto index = result_.eval(to_json(val));
             if (index.template is<size_t>())
             {
                 size_t start = index. template as<size_t>();
                 if (val.is_array() && start < val.size())
                 {
-                    nodes.emplace_back(PathCons()(path,start),std::addressof(val[start]));
+                    nodes.emplace_back(PathCons()(path,start),val.at(start));
                 }
             }
             else if (index.is_string())
@@ -207,34 +256,36 @@ private:
     class filter_selector : public selector
     {
     private:
-         jsonpath_filter_expr<Json> result_;
+         jsonpath_filter_expr<json_type> result_;
     public:
-        filter_selector(const jsonpath_filter_expr<Json>& result)
+        filter_selector(const jsonpath_filter_expr<json_type>& result)
             : result_(result)
         {
         }
 
         void select(node_type& node, const string_type& path, reference val, 
-                    node_set& nodes, std::vector<std::shared_ptr<Json>>&) override
+                    node_set& nodes, std::vector<std::shared_ptr<json_type>>&) override
         {
             if (val.is_array())
             {
                 node.skip_contained_object =true;
-                for (size_t i = 0; i < val.size(); ++i)
+                size_t i = 0;
+                for (auto& elem : val.array_range())
                 {
-                    if (result_.exists(val[i]))
+                    if (result_.exists(to_json(elem)))
                     {
-                        nodes.emplace_back(PathCons()(path,i),std::addressof(val[i]));
+                        nodes.emplace_back(PathCons()(path,i),elem);
                     }
+                    ++i;
                 }
             }
             else if (val.is_object())
             {
                 if (!node.skip_contained_object)
                 {
-                    if (result_.exists(val))
+                    if (result_.exists(to_json(val)))
                     {
-                        nodes.emplace_back(path, std::addressof(val));
+                        nodes.emplace_back(path, val);
                     }
                 }
                 else
@@ -258,11 +309,11 @@ private:
 
         void select(node_type& node, const string_type& path, reference val,
                     node_set& nodes,
-                    std::vector<std::shared_ptr<Json>>& temp_json_values) override
+                    std::vector<std::shared_ptr<json_type>>& temp_json_values) override
         {
-            if (val.is_object() && val.count(name_) > 0)
+            if (val.is_object() && val.has_key(name_))
             {
-                nodes.emplace_back(PathCons()(path,name_),std::addressof(val.at(name_)));
+                nodes.emplace_back(PathCons()(path,name_),val.at(name_));
             }
             else if (val.is_array())
             {
@@ -272,37 +323,32 @@ private:
                     size_t index = positive_start_ ? pos : val.size() - pos;
                     if (index < val.size())
                     {
-                        nodes.emplace_back(PathCons()(path,index),std::addressof(val[index]));
+                        nodes.emplace_back(PathCons()(path,index),val.at(index));
                     }
                 }
                 else if (name_ == length_literal() && val.size() > 0)
                 {
-                    auto temp = std::make_shared<Json>(val.size());
-                    temp_json_values.push_back(temp);
-                    nodes.emplace_back(PathCons()(path,name_),temp.get());
+                    add_computed(nodes, PathCons()(path,name_), std::make_shared<json_type>(val.size()), temp_json_values);
                 }
             }
             else if (val.is_string())
             {
                 size_t pos = 0;
-                string_view_type sv = val.as_string_view();
+                const json_type& s = to_json(val);
+                string_view_type sv = s.as_string_view();
                 if (try_string_to_index(name_.data(), name_.size(), &pos, &positive_start_))
                 {
                     size_t index = positive_start_ ? pos : sv.size() - pos;
                     auto sequence = unicons::sequence_at(sv.data(), sv.data() + sv.size(), index);
                     if (sequence.length() > 0)
                     {
-                        auto temp = std::make_shared<Json>(sequence.begin(),sequence.length());
-                        temp_json_values.push_back(temp);
-                        nodes.emplace_back(PathCons()(path,index),temp.get());
+                        add_computed(nodes, PathCons()(path,index), std::make_shared<json_type>(sequence.begin(),sequence.length()), temp_json_values);
                     }
                 }
                 else if (name_ == length_literal() && sv.size() > 0)
                 {
                     size_t count = unicons::u32_length(sv.begin(),sv.end());
-                    auto temp = std::make_shared<Json>(count);
-                    temp_json_values.push_back(temp);
-                    nodes.emplace_back(PathCons()(path,name_),temp.get());
+                    add_computed(nodes, PathCons()(path,name_), std::make_shared<json_type>(count), temp_json_values);
                 }
             }
         }
@@ -331,7 +377,7 @@ private:
 
         void select(node_type& node, const string_type& path, reference val,
                     node_set& nodes,
-                    std::vector<std::shared_ptr<Json>>&) override
+                    std::vector<std::shared_ptr<json_type>>&) override
         {
             if (positive_step_)
             {
@@ -361,7 +407,7 @@ private:
                 {
                     if (j < val.size())
                     {
-                        nodes.emplace_back(PathCons()(path,j),std::addressof(val[j]));
+                        nodes.emplace_back(PathCons()(path,j),val.at(j));
                     }
                 }
             }
@@ -388,7 +434,7 @@ private:
                     j -= step_;
                     if (j < val.size())
                     {
-                        nodes.emplace_back(PathCons()(path,j),std::addressof(val[j]));
+                        nodes.emplace_back(PathCons()(path,j),val.at(j));
                     }
                 }
             }
@@ -409,7 +455,7 @@ private:
     bool recursive_descent_;
     node_set nodes_;
     std::vector<node_set> stack_;
-    std::vector<std::shared_ptr<Json>> temp_json_values_;
+    std::vector<std::shared_ptr<json_type>> temp_json_values_;
     size_t line_;
     size_t column_;
     const char_type* begin_input_;
@@ -431,24 +477,31 @@ public:
     {
     }
 
-    Json get_values() const
+    json_type get_values() const
     {
-        Json result = typename Json::array();
+        json_type result = typename json_type::array();
 
         if (stack_.size() > 0)
         {
             result.reserve(stack_.back().size());
             for (const auto& p : stack_.back())
             {
-                result.push_back(*(p.val_ptr));
+                if (p.computed != nullptr)
+                {
+                    result.push_back(*(p.computed));
+                }
+                else
+                {
+                    result.push_back(to_json(p.val.get()));
+                }
             }
         }
         return result;
     }
 
-    Json get_normalized_paths() const
+    json_type get_normalized_paths() const
     {
-        Json result = typename Json::array();
+        json_type result = typename json_type::array();
         if (stack_.size() > 0)
         {
             result.reserve(stack_.back().size());
@@ -467,7 +520,7 @@ public:
         {
             for (size_t i = 0; i < stack_.back().size(); ++i)
             {
-                *(stack_.back()[i].val_ptr) = new_value;
+                stack_.back()[i].val.get() = new_value;
             }
         }
     }
@@ -547,7 +600,7 @@ public:
                         string_type s;
                         s.push_back('$');
                         node_set v;
-                        v.emplace_back(std::move(s),std::addressof(root));
+                        v.emplace_back(std::move(s),root);
                         stack_.push_back(v);
 
                         state_ = path_state::expect_dot_or_left_bracket;
@@ -648,7 +701,7 @@ public:
                     break;
                 case '(':
                     {
-                        jsonpath_filter_parser<Json> parser(line_,column_);
+                        jsonpath_filter_parser<json_type> parser(line_,column_);
                         auto result = parser.parse(root, p_,end_input_,&p_);
                         line_ = parser.line();
                         column_ = parser.column();
@@ -658,7 +711,7 @@ public:
                     break;
                 case '?':
                     {
-                        jsonpath_filter_parser<Json> parser(line_,column_);
+                        jsonpath_filter_parser<json_type> parser(line_,column_);
                         auto result = parser.parse(root,p_,end_input_,&p_);
                         line_ = parser.line();
                         column_ = parser.column();
@@ -944,21 +997,26 @@ public:
     {
         for (size_t i = 0; i < stack_.back().size(); ++i)
         {
+            if (stack_.back()[i].computed != nullptr)
+            {
+                continue;
+            }
             const auto& path = stack_.back()[i].path;
-            pointer p = stack_.back()[i].val_ptr;
+            auto&& val = stack_.back()[i].val.get();
 
-            if (p->is_array())
+            if (val.is_array())
             {
-                for (auto it = p->array_range().begin(); it != p->array_range().end(); ++it)
+                size_t index = 0;
+                for (auto& elem : val.array_range())
                 {
-                    nodes_.emplace_back(PathCons()(path,it - p->array_range().begin()),std::addressof(*it));
+                    nodes_.emplace_back(PathCons()(path,index++),elem);
                 }
             }
-            else if (p->is_object())
+            else if (val.is_object())
             {
-                for (auto it = p->object_range().begin(); it != p->object_range().end(); ++it)
+                for (auto& member : val.object_range())
                 {
-                    nodes_.emplace_back(PathCons()(path,it->key()),std::addressof(it->value()));
+                    nodes_.emplace_back(PathCons()(path,member.key()),member.value());
                 }
             }
 
@@ -972,7 +1030,10 @@ public:
         {
             for (size_t i = 0; i < stack_.back().size(); ++i)
             {
-                apply_unquoted_string(stack_.back()[i].path, *(stack_.back()[i].val_ptr), name);
+                if (stack_.back()[i].computed == nullptr)
+                {
+                    apply_unquoted_string(stack_.back()[i].path, stack_.back()[i].val.get(), name);
+                }
             }
         }
         buffer_.clear();
@@ -982,17 +1043,17 @@ public:
     {
         if (val.is_object())
         {
-            if (val.count(name) > 0)
+            if (val.has_key(name))
             {
-                nodes_.emplace_back(PathCons()(path,name),std::addressof(val.at(name)));
+                nodes_.emplace_back(PathCons()(path,name),val.at(name));
             }
             if (recursive_descent_)
             {
-                for (auto it = val.object_range().begin(); it != val.object_range().end(); ++it)
+                for (auto& member : val.object_range())
                 {
-                    if (it->value().is_object() || it->value().is_array())
+                    if (member.value().is_object() || member.value().is_array())
                     {
-                        apply_unquoted_string(path, it->value(), name);
+                        apply_unquoted_string(path, member.value(), name);
                     }
                 }
             }
@@ -1005,46 +1066,41 @@ public:
                 size_t index = positive_start_ ? pos : val.size() - pos;
                 if (index < val.size())
                 {
-                    nodes_.emplace_back(PathCons()(path,index),std::addressof(val[index]));
+                    nodes_.emplace_back(PathCons()(path,index),val.at(index));
                 }
             }
             else if (name == length_literal() && val.size() > 0)
             {
-                auto temp = std::make_shared<Json>(val.size());
-                temp_json_values_.push_back(temp);
-                nodes_.emplace_back(PathCons()(path,name),temp.get());
+                add_computed(nodes_, PathCons()(path,name), std::make_shared<json_type>(val.size()), temp_json_values_);
             }
             if (recursive_descent_)
             {
-                for (auto it = val.array_range().begin(); it != val.array_range().end(); ++it)
+                for (auto& elem : val.array_range())
                 {
-                    if (it->is_object() || it->is_array())
+                    if (elem.is_object() || elem.is_array())
                     {
-                        apply_unquoted_string(path, *it, name);
+                        apply_unquoted_string(path, elem, name);
                     }
                 }
             }
         }
         else if (val.is_string())
         {
-            string_view_type sv = val.as_string_view();
+            const json_type& s = to_json(val);
+            string_view_type sv = s.as_string_view();
             size_t pos = 0;
             if (try_string_to_index(name.data(),name.size(),&pos, &positive_start_))
             {
                 auto sequence = unicons::sequence_at(sv.data(), sv.data() + sv.size(), pos);
                 if (sequence.length() > 0)
                 {
-                    auto temp = std::make_shared<Json>(sequence.begin(),sequence.length());
-                    temp_json_values_.push_back(temp);
-                    nodes_.emplace_back(PathCons()(path,pos),temp.get());
+                    add_computed(nodes_, PathCons()(path,pos), std::make_shared<json_type>(sequence.begin(),sequence.length()), temp_json_values_);
                 }
             }
             else if (name == length_literal() && sv.size() > 0)
             {
                 size_t count = unicons::u32_length(sv.begin(),sv.end());
-                auto temp = std::make_shared<Json>(count);
-                temp_json_values_.push_back(temp);
-                nodes_.emplace_back(PathCons()(path,name),temp.get());
+                add_computed(nodes_, PathCons()(path,name), std::make_shared<json_type>(count), temp_json_values_);
             }
         }
     }
@@ -1056,7 +1112,10 @@ public:
             for (size_t i = 0; i < stack_.back().size(); ++i)
             {
                 node_type& node = stack_.back()[i];
-                apply_selectors(node, node.path, *(node.val_ptr));
+                if (node.computed == nullptr)
+                {
+                    apply_selectors(node, node.path, node.val.get());
+                }
             }
             selectors_.clear();
         }
@@ -1174,7 +1174,9 @@ public:
         return column_;
     }
 
-    jsonpath_filter_expr<Json> parse(const Json& root, const char_type* p, size_t length, const char_type** end_ptr)
+    // Root is Json, or a view, such as a cbor_view, that decodes into Json
+    template <class Root>
+    jsonpath_filter_expr<Json> parse(const Root& root, const char_type* p, size_t length, const char_type** end_ptr)
     {
         return parse(root, p,p+length, end_ptr);
     }
@@ -1248,7 +1250,8 @@ public:
         }
     }
 
-    jsonpath_filter_expr<Json> parse(const Json& root, const char_type* p, const char_type* end_expr, const char_type** end_ptr)
+    template <class Root>
+    jsonpath_filter_expr<Json> parse(const Root& root, const char_type* p, const char_type* end_expr, const char_type** end_ptr)
     {
         output_stack_.clear();
         operator_stack_.clear();
@@ -1332,7 +1335,7 @@ public:
                                 try
                                 {
                                     // path, parse against root, get value
-                                    jsonpath_evaluator<Json,const Json&,detail::VoidPathConstructor<Json>> evaluator;
+                                    jsonpath_evaluator<Root,const Root&,detail::VoidPathConstructor<Root>> evaluator;
                                     evaluator.evaluate(root,buffer.data(),buffer.length());
                                     auto result = evaluator.get_values();
                                     add_token(token<Json>(token_type::operand,std::make_shared<value_term<Json>>(result)));
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <memory>
 #include <jsoncons/json.hpp>
+#include <jsoncons/detail/json_wrapper.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer_error_category.hpp>
 
 namespace jsoncons { namespace jsonpointer {
@@ -66,62 +67,7 @@ enum class pointer_state
     object_reference_token,
     escaped
 };
-template <class Json,class JsonReference, class Enable = void>
-class json_wrapper
-{
-};
-
-template <class Json,class JsonReference>
-class json_wrapper<Json,JsonReference,typename std::enable_if<std::is_reference<decltype(std::declval<Json>().at(typename Json::string_view_type()))>::value>::type>
-{
-public:
-    using reference = JsonReference;
-    using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
-
-    json_wrapper(reference ref) JSONCONS_NOEXCEPT
-        : ptr_(std::addressof(ref))
-    {
-    }
-
-    json_wrapper(const json_wrapper&) JSONCONS_NOEXCEPT = default;
-
-    json_wrapper& operator=(const json_wrapper&) JSONCONS_NOEXCEPT = default;
-
-    reference get() const JSONCONS_NOEXCEPT
-    {
-        return *ptr_;
-    }
-private:
-    pointer ptr_;
-};
-
-template <class Json,class JsonReference>
-class json_wrapper<Json,JsonReference,typename std::enable_if<!std::is_reference<decltype(std::declval<Json>().at(typename Json::string_view_type()))>::value>::type>
-{
-public:
-    using value_type = typename Json::value_type;
-    using reference = JsonReference;
-    using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
-
-    json_wrapper(reference ref) JSONCONS_NOEXCEPT
-        : val_(ref)
-    {
-    }
-
-    json_wrapper(const json_wrapper& w) JSONCONS_NOEXCEPT
-        : val_(w.val_)
-    {
-    }
-
-    json_wrapper& operator=(const json_wrapper&) JSONCONS_NOEXCEPT = default;
-
-    value_type get() const JSONCONS_NOEXCEPT
-    {
-        return val_;
-    }
-private:
-    value_type val_;
-};
+using jsoncons::detail::json_wrapper;
 
 template<class Json,class JsonReference>
 struct path_resolver
@@ -0,0 +1,121 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/arena_allocator.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <limits>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(arena_allocator_tests)
+
+static std::string make_document(size_t count)
+{
+    std::string s = "{\"records\":[";
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(",");
+        }
+        s.append("{\"id\":" + std::to_string(i) + ",\"description\":\"a string too long to be stored inline "
+                 + std::to_string(i) + "\",\"values\":[1.5,true,null]}");
+    }
+    s.append("]}");
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_monotonic_arena)
+{
+    monotonic_arena arena(64);
+    BOOST_CHECK_EQUAL(0, arena.block_count());
+
+    void* p = arena.allocate(10, 1);
+    void* q = arena.allocate(8, 8);
+    BOOST_CHECK(p != q);
+    BOOST_CHECK_EQUAL(0, reinterpret_cast<uintptr_t>(q) % 8);
+    BOOST_CHECK_EQUAL(1, arena.block_count());
+
+    // Larger than the next block
+    arena.allocate(1000, 16);
+    BOOST_CHECK_EQUAL(2, arena.block_count());
+    BOOST_CHECK_EQUAL(1018, arena.bytes_allocated());
+
+    arena.reset();
+    BOOST_CHECK_EQUAL(1, arena.block_count());
+    BOOST_CHECK_EQUAL(0, arena.bytes_allocated());
+    arena.allocate(512, 8);
+    BOOST_CHECK_EQUAL(1, arena.block_count());
+}
+
+BOOST_AUTO_TEST_CASE(test_monotonic_arena_too_large)
+{
+    // Requests too large for a block throw rather than wrap around or loop forever
+    monotonic_arena arena(64);
+    const size_t max = (std::numeric_limits<size_t>::max)();
+    BOOST_CHECK_THROW(arena.allocate(max, 8), std::bad_alloc);
+    BOOST_CHECK_THROW(arena.allocate(max - 4, 8), std::bad_alloc);
+    BOOST_CHECK_THROW(arena.allocate(max/2 + 1, 8), std::bad_alloc);
+    BOOST_CHECK_EQUAL(0, arena.bytes_allocated());
+
+    arena_allocator<uint64_t> alloc(arena);
+    BOOST_CHECK_THROW(alloc.allocate(max/4), std::bad_alloc);
+
+    std::vector<uint64_t,arena_allocator<uint64_t>> v(alloc);
+    BOOST_CHECK_THROW(v.reserve(max/16), std::exception);
+
+    // The arena is still usable
+    BOOST_CHECK(arena.allocate(100, 8) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_json_decode)
+{
+    std::string s = make_document(1000);
+
+    monotonic_arena arena(4096);
+    json_decoder<arena_json> decoder{arena_allocator<char>(arena)};
+    json_reader reader(s, decoder);
+    reader.read();
+    BOOST_REQUIRE(decoder.is_valid());
+    arena_json j = decoder.get_result();
+
+    BOOST_CHECK(arena.bytes_allocated() > s.length());
+    BOOST_CHECK(arena.block_count() < 16);
+    BOOST_CHECK(j.object_value().get_allocator() == arena_allocator<char>(arena));
+
+    BOOST_REQUIRE_EQUAL(1000, j["records"].size());
+    BOOST_CHECK_EQUAL(999, j["records"][999]["id"].as<int>());
+    BOOST_CHECK_EQUAL(std::string("a string too long to be stored inline 7"),
+                      j["records"][7]["description"].as<std::string>());
+    BOOST_CHECK_EQUAL(arena_json::parse(s), j);
+
+    // Drop the document without destroying it node by node, and reuse the arena
+    arena.release(j);
+    BOOST_CHECK(j.is_null());
+    arena.reset();
+    BOOST_CHECK_EQUAL(1, arena.block_count());
+
+    json_decoder<arena_json> decoder2{arena_allocator<char>(arena)};
+    json_reader reader2(s, decoder2);
+    reader2.read();
+    arena_json j2 = decoder2.get_result();
+    BOOST_CHECK_EQUAL(1000, j2["records"].size());
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_json_default_allocator)
+{
+    // Values built without an arena use the heap and are freed normally
+    arena_ojson j = arena_ojson::parse(R"({"b":"a long string that will not fit inline","a":[1,2,3]})");
+    j["c"] = "another long string that will not fit inline";
+    arena_ojson k = j;
+    BOOST_CHECK_EQUAL(j, k);
+    BOOST_CHECK(j.object_value().get_allocator().arena() == nullptr);
+    BOOST_CHECK_EQUAL(std::string("b"), std::string(j.object_range().begin()->key()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
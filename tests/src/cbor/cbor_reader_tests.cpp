@@ -0,0 +1,195 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_filter.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/cbor/cbor_reader.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <limits>
+
+using namespace jsoncons;
+using namespace jsoncons::cbor;
+
+BOOST_AUTO_TEST_SUITE(cbor_reader_tests)
+
+json read_cbor(const std::vector<uint8_t>& v, size_t buffer_length)
+{
+    std::istringstream is(std::string(v.begin(), v.end()));
+    json_decoder<json> decoder;
+    cbor_reader reader(is, decoder);
+    reader.buffer_length(buffer_length);
+    reader.read();
+    return decoder.get_result();
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_chunk_boundaries)
+{
+    json j = json::parse(R"(
+    {
+        "integers" : [0, 23, 24, 255, 256, 65536, 4294967296, -1, -24, -25, -4294967297],
+        "max uint64" : 18446744073709551615,
+        "doubles" : [1.5, -0.25, 1e300],
+        "strings" : ["", "a", "a string long enough to need a one byte length", "é中"],
+        "nested" : [[], {}, [[{"a" : null, "b" : true, "c" : false}]]]
+    }
+    )");
+    j["bytes"] = byte_string("Hello");
+    json a = json::array();
+    for (size_t i = 0; i < 300; ++i)
+    {
+        a.push_back(i);
+    }
+    j["long array"] = a;
+
+    std::vector<uint8_t> v;
+    encode_cbor(j, v);
+
+    // Every chunk size, down to a byte at a time, cuts items at a different place
+    for (size_t buffer_length : {1, 2, 3, 7, 64, 16384})
+    {
+        BOOST_CHECK_EQUAL(j, read_cbor(v, buffer_length));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_indefinite_length)
+{
+    // {_ "a": [_ 1, [2, 3]], "b": (_ "strea", "ming"), "c": (_ h'0102', h'03')}
+    std::vector<uint8_t> v = {0xbf,
+                                0x61,'a',0x9f,0x01,0x82,0x02,0x03,0xff,
+                                0x61,'b',0x7f,0x65,'s','t','r','e','a',0x64,'m','i','n','g',0xff,
+                                0x61,'c',0x5f,0x42,0x01,0x02,0x41,0x03,0xff,
+                              0xff};
+    for (size_t buffer_length : {1, 5, 100})
+    {
+        json j = read_cbor(v, buffer_length);
+        BOOST_CHECK_EQUAL(json::parse(R"([1,[2,3]])"), j["a"]);
+        BOOST_CHECK_EQUAL(std::string("streaming"), j["b"].as<std::string>());
+        BOOST_CHECK(j["c"].as<byte_string>() == byte_string({0x01,0x02,0x03}));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_typed_array)
+{
+    // uint16 big endian, sint16 little endian, float32 big endian
+    std::vector<uint8_t> v = {0x83,
+                              0xd8,0x41,0x44,0x00,0x01,0x01,0x00,
+                              0xd8,0x4d,0x44,0xff,0xff,0x02,0x00,
+                              0xd8,0x51,0x48,0x3f,0xc0,0x00,0x00,0xbe,0x80,0x00,0x00};
+    json j = read_cbor(v, 3);
+    BOOST_CHECK_EQUAL(json::parse("[[1,256],[-1,2],[1.5,-0.25]]"), j);
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_to_json_text)
+{
+    json j = json::parse(R"({"a":[1,-2,3.5,"four",true,null,{"b":[]}],"c":{}})");
+    std::ostringstream cbor_os;
+    encode_cbor(j, cbor_os);
+
+    std::istringstream is(cbor_os.str());
+    std::ostringstream os;
+    json_serializer serializer(os);
+    json_filter filter(serializer);
+    cbor_reader reader(is, filter);
+    reader.read();
+    BOOST_CHECK_EQUAL(j, json::parse(os.str()));
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_sequence)
+{
+    std::vector<uint8_t> v;
+    encode_cbor(json::parse("[1,2]"), v);
+    encode_cbor(json("three"), v);
+
+    // Whether or not the last item ends at a buffer boundary
+    for (size_t buffer_length : {1, 2, 5, 100})
+    {
+        std::istringstream is(std::string(v.begin(), v.end()));
+        json_decoder<json> decoder;
+        cbor_reader reader(is, decoder);
+        reader.buffer_length(buffer_length);
+
+        std::vector<json> items;
+        while (!reader.eof())
+        {
+            reader.read();
+            items.push_back(decoder.get_result());
+        }
+        BOOST_REQUIRE_EQUAL(2, items.size());
+        BOOST_CHECK_EQUAL(json::parse("[1,2]"), items[0]);
+        BOOST_CHECK_EQUAL(json("three"), items[1]);
+
+        // Reading on at the end is not an error
+        std::error_code ec;
+        reader.read(ec);
+        BOOST_CHECK(!ec);
+        BOOST_CHECK(!decoder.is_valid());
+        BOOST_CHECK(reader.eof());
+    }
+
+    std::istringstream empty;
+    json_decoder<json> decoder;
+    cbor_reader reader(empty, decoder);
+    std::error_code ec;
+    reader.read(ec);
+    BOOST_CHECK(!ec);
+    BOOST_CHECK(reader.eof());
+
+    // A stream that ends partway through an item is truncated
+    std::string truncated = {'\x82','\x01'};
+    std::istringstream is(truncated);
+    cbor_reader reader2(is, decoder);
+    reader2.read(ec);
+    BOOST_CHECK(ec == cbor_parser_errc::unexpected_eof);
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_wide)
+{
+    wjson j = wjson::parse(LR"({"name":"été","values":[1,2.5]})");
+    std::vector<uint8_t> v;
+    encode_cbor(j, v);
+
+    std::istringstream is(std::string(v.begin(), v.end()));
+    json_decoder<wjson> decoder;
+    wcbor_reader reader(is, decoder);
+    reader.read();
+    BOOST_CHECK(j == decoder.get_result());
+}
+
+BOOST_AUTO_TEST_CASE(cbor_reader_errors)
+{
+    std::error_code ec;
+    json_decoder<json> decoder;
+    cbor_parser parser(decoder);
+
+    std::vector<uint8_t> truncated = {0x82,0x01};
+    parser.update(truncated.data(), truncated.size());
+    parser.parse_some(ec);
+    BOOST_CHECK(!ec);
+    BOOST_CHECK(!parser.done());
+    parser.end_parse(ec);
+    BOOST_CHECK(ec == cbor_parser_errc::unexpected_eof);
+
+    std::vector<uint8_t> integer_key = {0xa1,0x01,0x02};
+    parser.reset();
+    ec = std::error_code();
+    parser.update(integer_key.data(), integer_key.size());
+    parser.parse_some(ec);
+    BOOST_CHECK(ec == cbor_parser_errc::expected_text_string_key);
+
+    std::vector<uint8_t> stray_break = {0x81,0xff};
+    parser.reset();
+    ec = std::error_code();
+    parser.update(stray_break.data(), stray_break.size());
+    parser.parse_some(ec);
+    BOOST_CHECK(ec == cbor_parser_errc::unexpected_break);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
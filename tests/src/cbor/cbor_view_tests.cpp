@@ -9,6 +9,7 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/cbor/cbor.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -86,5 +87,199 @@ BOOST_AUTO_TEST_CASE(jsonpointer_test)
 
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(cbor_view_indexed_lookup)
+{
+    json j = json::object();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        json record = json::object();
+        record["id"] = i;
+        record["tags"] = json::array({"a", std::to_string(i)});
+        j.set("key" + std::to_string(i), record);
+    }
+    json a = json::array();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        a.push_back(json::array({i, i*2}));
+    }
+    j["array"] = a;
+
+    std::vector<uint8_t> buffer;
+    encode_cbor(j, buffer);
+
+    cbor_view v(buffer);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        std::string key = "key" + std::to_string(i);
+        BOOST_CHECK(v.has_key(key));
+        cbor_view record = v.at(key);
+        BOOST_CHECK_EQUAL(j[key], decode_cbor<json>(record));
+        BOOST_CHECK_EQUAL(i, decode_cbor<json>(record.at("id")).as<size_t>());
+
+        cbor_view element = v.at("array").at(i);
+        BOOST_CHECK_EQUAL(a[i], decode_cbor<json>(element));
+    }
+    BOOST_CHECK(!v.has_key("key100"));
+    BOOST_CHECK_THROW(v.at("key100"), std::runtime_error);
+    BOOST_CHECK_THROW(v.at("array").at(100), std::out_of_range);
+}
 
+BOOST_AUTO_TEST_CASE(cbor_view_indexed_duplicate_keys)
+{
+    // A map of 16 entries, all with key "a", finds the first, as a walk does
+    std::vector<uint8_t> buffer = {0xb0};
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+        buffer.push_back(0x61);
+        buffer.push_back('a');
+        buffer.push_back(i);
+    }
+    cbor_view v(buffer);
+    BOOST_CHECK_EQUAL(0, decode_cbor<json>(v.at("a")).as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(cbor_view_iterators)
+{
+    ojson j = ojson::parse(R"({"a" : [1, [2, 3], "four"], "b" : {}, "c" : null})");
+    std::vector<uint8_t> buffer;
+    encode_cbor(j, buffer);
+
+    cbor_view v(buffer);
+    std::vector<std::string> keys;
+    for (const auto& kv : v.object_range())
+    {
+        keys.emplace_back(kv.key().data(), kv.key().length());
+        BOOST_CHECK_EQUAL(j[kv.key()], decode_cbor<ojson>(kv.value()));
+    }
+    BOOST_CHECK((keys == std::vector<std::string>{"a","b","c"}));
+
+    size_t count = 0;
+    for (const auto& element : v.at("a").array_range())
+    {
+        BOOST_CHECK_EQUAL(j["a"][count], decode_cbor<ojson>(element));
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(3, count);
+    BOOST_CHECK(v.at("b").object_range().begin() == v.at("b").object_range().end());
+
+    // [_ 1, [_ 2], (_ "ab", "c")] and {_ "x": 1}
+    std::vector<uint8_t> indefinite = {0x9f,0x01,0x9f,0x02,0xff,0x7f,0x62,'a','b',0x61,'c',0xff,0xbf,0x61,'x',0x01,0xff,0xff};
+    cbor_view w(indefinite);
+    BOOST_CHECK_EQUAL(4, w.size());
+    std::vector<json> elements;
+    for (const auto& element : w.array_range())
+    {
+        elements.push_back(decode_cbor<json>(element));
+    }
+    BOOST_REQUIRE_EQUAL(4, elements.size());
+    BOOST_CHECK_EQUAL(json::parse("[2]"), elements[1]);
+    BOOST_CHECK_EQUAL(json("abc"), elements[2]);
+    BOOST_CHECK_EQUAL(json::parse(R"({"x":1})"), elements[3]);
+    BOOST_CHECK_EQUAL(json("abc"), decode_cbor<json>(w.at(2)));
+    BOOST_CHECK_EQUAL(1, w.at(3).object_range().begin()->value().buffer()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(cbor_view_indexed_indefinite_length)
+{
+    // [_ 0, 1, ..., 99] and {_ "k0": 0, ..., "k99": 99}, looked up through their indexes
+    // after the first access, including an out of range index and a missing key
+    std::vector<uint8_t> array = {0x9f};
+    std::vector<uint8_t> map = {0xbf};
+    for (uint8_t i = 0; i < 100; ++i)
+    {
+        array.push_back(0x18);
+        array.push_back(i);
+        std::string key = "k" + std::to_string(i);
+        map.push_back(static_cast<uint8_t>(0x60 + key.length()));
+        map.insert(map.end(), key.begin(), key.end());
+        map.push_back(0x18);
+        map.push_back(i);
+    }
+    array.push_back(0xff);
+    map.push_back(0xff);
+
+    cbor_view a(array);
+    cbor_view m(map);
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        BOOST_CHECK_EQUAL(100, a.size());
+        BOOST_CHECK_EQUAL(100, m.size());
+        for (size_t i = 0; i < 100; ++i)
+        {
+            std::string key = "k" + std::to_string(i);
+            BOOST_CHECK_EQUAL(i, decode_cbor<json>(a.at(i)).as<size_t>());
+            BOOST_CHECK(m.has_key(key));
+            BOOST_CHECK_EQUAL(i, decode_cbor<json>(m.at(key)).as<size_t>());
+        }
+        BOOST_CHECK_THROW(a.at(100), std::out_of_range);
+        BOOST_CHECK(!m.has_key("k100"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cbor_view_chunked_keys)
+{
+    // {"ab": 1, (_ "a", "b"): 2, "abc": 3}, the chunked key found as "ab" after the first
+    std::vector<uint8_t> small = {0xa3,0x62,'a','b',0x01,0x7f,0x61,'a',0x61,'b',0xff,0x02,0x63,'a','b','c',0x03};
+    cbor_view v(small);
+    BOOST_CHECK_EQUAL(1, decode_cbor<json>(v.at("ab")).as<int>());
+    BOOST_CHECK_EQUAL(3, decode_cbor<json>(v.at("abc")).as<int>());
+    BOOST_CHECK(!v.has_key("a"));
+
+    // {_ (_ "k", "00"): 0, ..., (_ "k", "19"): 19}, indexed
+    std::vector<uint8_t> large = {0xbf};
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        std::vector<uint8_t> key = {0x7f,0x61,'k',0x62,static_cast<uint8_t>('0' + i/10),static_cast<uint8_t>('0' + i%10),0xff};
+        large.insert(large.end(), key.begin(), key.end());
+        large.push_back(i);
+    }
+    large.push_back(0xff);
+    cbor_view w(large);
+    BOOST_CHECK_EQUAL(7, decode_cbor<json>(w.at("k07")).as<int>());
+    BOOST_CHECK_EQUAL(19, decode_cbor<json>(w.at("k19")).as<int>());
+    BOOST_CHECK(!w.has_key("k20"));
+
+    // Keys from the iterator stay valid in copies
+    std::vector<cbor_key_value> members(w.object_range().begin(), w.object_range().end());
+    BOOST_REQUIRE_EQUAL(20, members.size());
+    BOOST_CHECK(members[12].key() == "k12");
+    BOOST_CHECK(v.object_range().begin()->key() == "ab");
+}
+
+BOOST_AUTO_TEST_CASE(cbor_view_json_query)
+{
+    json j = json::parse(R"(
+    {
+        "store": {
+            "book": [
+                {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+                {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+                {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99},
+                {"category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings", "isbn": "0-395-19395-8", "price": 22.99}
+            ],
+            "bicycle": {"color": "red", "price": 19.95}
+        }
+    }
+    )");
+    std::vector<uint8_t> buffer;
+    encode_cbor(j, buffer);
+    cbor_view v(buffer);
+
+    std::vector<std::string> paths = {"$.store.book[1].author", "$..author", "$.store.*", "$.store.book[-1:]",
+                                      "$.store.book[0:4:2].title", "$..book[?(@.isbn)].title", "$..book[?(@.price < 10)].price",
+                                      "$.store.book[(@.length-1)].title", "$.store.book.length", "$.store.bicycle.color[0]",
+                                      "$..price", "$.store['bicycle','book'][0]", "$.nothing"};
+    for (const auto& path : paths)
+    {
+        BOOST_CHECK_EQUAL(jsonpath::json_query(decode_cbor<json>(v), path), jsonpath::json_query(v, path));
+        BOOST_CHECK_EQUAL(jsonpath::json_query(decode_cbor<json>(v), path, jsonpath::result_type::path), 
+                          jsonpath::json_query(v, path, jsonpath::result_type::path));
+    }
+
+    cbor_view title = jsonpointer::get(v, "/store/book/3/title");
+    BOOST_CHECK_EQUAL(std::string("The Lord of the Rings"), title.as<json>().as<std::string>());
+    BOOST_CHECK(jsonpointer::contains(v, "/store/bicycle/color"));
+    BOOST_CHECK(!jsonpointer::contains(v, "/store/book/4"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,7 @@
 #include <utility>
 #include <ctime>
 #include <limits>
+#include <cstring>
 
 using namespace jsoncons;
 using namespace jsoncons::cbor;
@@ -142,5 +143,42 @@ BOOST_AUTO_TEST_CASE(cbor_arrays_and_maps)
     check_decode({0xa1,0x62,'o','c',0x84,'\0','\1','\2','\3'}, json::parse("{\"oc\": [0, 1, 2, 3]}"));
 }
 
+struct packing_policy : public sorted_policy
+{
+    static const size_t packed_array_threshold = 16;
+};
+
+typedef basic_json<char,packing_policy> packed_json;
+
+BOOST_AUTO_TEST_CASE(cbor_typed_arrays)
+{
+    // uint16 big endian, sint32 little endian, float32 big endian
+    check_decode({0xd8,0x41,0x44,0x00,0x01,0x01,0x00}, json::array({1,256}));
+    check_decode({0xd8,0x4e,0x48,0xff,0xff,0xff,0xff,0x02,0x00,0x00,0x00}, json::array({-1,2}));
+    check_decode({0xd8,0x51,0x48,0x3f,0xc0,0x00,0x00,0xc0,0x20,0x00,0x00}, json::array({1.5,-2.5}));
+
+    // float64 little endian, long enough to be packed
+    std::vector<uint8_t> v = {0xd8,0x56,0x58,0x80};
+    std::vector<double> expected;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        double x = i * 0.5;
+        expected.push_back(x);
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        for (size_t k = 0; k < 8; ++k)
+        {
+            v.push_back(static_cast<uint8_t>(bits >> (8*k)));
+        }
+    }
+    packed_json j = decode_cbor<packed_json>(v);
+    BOOST_CHECK(j.array_value().packing() == packed_kind::floating);
+    BOOST_CHECK(j.as<std::vector<double>>() == expected);
+
+    std::vector<uint8_t> u;
+    encode_cbor(j, u);
+    BOOST_CHECK_EQUAL(json(expected), decode_cbor<json>(u));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
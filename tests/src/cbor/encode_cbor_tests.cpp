@@ -7,6 +7,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <jsoncons/json.hpp>
+#include <jsoncons/json_filter.hpp>
 #include <jsoncons_ext/cbor/cbor.hpp>
 #include <sstream>
 #include <vector>
@@ -116,5 +117,51 @@ BOOST_AUTO_TEST_CASE(cbor_arrays_and_maps)
     check_encode({0xa1,0x62,'o','c',0x84,'\0','\1','\2','\3'}, json::parse("{\"oc\": [0, 1, 2, 3]}"));
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(cbor_serializer_patches_lengths)
+{
+    // Containers whose length needs a byte or more of its own after the initial byte
+    for (size_t n : {23, 24, 255, 256, 65536})
+    {
+        json a = json::array();
+        json o = json::object();
+        for (size_t i = 0; i < n; ++i)
+        {
+            a.push_back(json::array({i, "a"}));
+            o.set(std::to_string(i), i);
+        }
+        json j = json::array({a, o});
+
+        std::vector<uint8_t> expected;
+        cbor_Encoder_<json>::encode(j, Encode_cbor_(), expected);
+
+        std::vector<uint8_t> result;
+        cbor_serializer serializer(result);
+        j.dump(serializer);
+        BOOST_REQUIRE(expected == result);
+        BOOST_CHECK_EQUAL(j, decode_cbor<json>(result));
+    }
+}
 
+BOOST_AUTO_TEST_CASE(cbor_serializer_transcode_stream)
+{
+    std::string s = R"({"a":[1,-2,3.5,"four",true,null,{"b":[]}],"c":{}})";
+
+    std::ostringstream os;
+    cbor_serializer serializer(os);
+    std::istringstream is(s);
+    json_filter filter(serializer);
+    json_reader reader(is, filter);
+    reader.read();
+
+    std::string bytes = os.str();
+    std::vector<uint8_t> v(bytes.begin(), bytes.end());
+    BOOST_CHECK_EQUAL(0xbf, v.front());
+    BOOST_CHECK_EQUAL(0xff, v.back());
+    BOOST_CHECK_EQUAL(json::parse(s), decode_cbor<json>(v));
+
+    std::ostringstream os2;
+    encode_cbor(json::parse(s), os2);
+    BOOST_CHECK(os2.str() == bytes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
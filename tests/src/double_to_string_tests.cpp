@@ -13,6 +13,8 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <cstring>
+#include <cstdlib>
 
 using namespace jsoncons;
 
@@ -173,5 +175,40 @@ BOOST_AUTO_TEST_CASE(test_double_to_wstring)
     s = float_to_string<wchar_t>(x, std::numeric_limits<double>::digits10);
     BOOST_CHECK(s == std::wstring(L"-11.0"));
 }
+BOOST_AUTO_TEST_CASE(test_double_to_string_shortest)
+{
+    // Without a precision, the shortest representation that reads back to the same value
+    BOOST_CHECK(float_to_string<char>(0.1, 0) == std::string("0.1"));
+    BOOST_CHECK(float_to_string<char>(0.1 + 0.2, 0) == std::string("0.30000000000000004"));
+    BOOST_CHECK(float_to_string<char>(1.0, 0) == std::string("1.0"));
+    BOOST_CHECK(float_to_string<char>(-10.0, 0) == std::string("-10.0"));
+    BOOST_CHECK(float_to_string<char>(0.0, 0) == std::string("0.0"));
+    BOOST_CHECK(float_to_string<char>(1.0e100, 0) == std::string("1.0e+100"));
+    BOOST_CHECK(float_to_string<char>(1.23456789e-101, 0) == std::string("1.23456789e-101"));
+    BOOST_CHECK(float_to_string<char>(0.000123, 0) == std::string("0.000123"));
+    BOOST_CHECK(float_to_string<char>(1.0e-5, 0) == std::string("1.0e-05"));
+    BOOST_CHECK(float_to_string<char>(123456789012345.0, 0) == std::string("123456789012345.0"));
+    BOOST_CHECK(float_to_string<char>(1.0e15, 0) == std::string("1.0e+15"));
+    BOOST_CHECK(float_to_string<char>(5e-324, 0) == std::string("5.0e-324"));
+    BOOST_CHECK(float_to_string<char>((std::numeric_limits<double>::max)(), 0) == std::string("1.7976931348623157e+308"));
+    BOOST_CHECK(float_to_string<wchar_t>(42.23, 0) == std::wstring(L"42.23"));
+
+    uint64_t bits = 0x2545f4914f6cdd1dULL;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        if (!(x == x) || x - x != 0)
+        {
+            continue;
+        }
+        std::string s = float_to_string<char>(x, 0);
+        BOOST_REQUIRE_MESSAGE(std::strtod(s.c_str(), nullptr) == x, s);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
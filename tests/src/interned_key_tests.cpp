@@ -0,0 +1,191 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/interned_key.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(interned_key_tests)
+
+BOOST_AUTO_TEST_CASE(test_interned_key)
+{
+    typedef interned_key<char> key_type;
+
+    std::string s1 = "a member name longer than the small string buffer";
+    std::string s2 = s1;
+    key_type a(s1.data(), s1.length());
+    key_type b(s2.data(), s2.data() + s2.length());
+    key_type c("other", 5);
+
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(a.data() == b.data());
+    BOOST_CHECK_EQUAL(a.id(), b.id());
+    BOOST_CHECK(a != c);
+    BOOST_CHECK(a.id() != c.id());
+    BOOST_CHECK(a == key_type::string_view_type(s1));
+    BOOST_CHECK_EQUAL(0, a.compare(b));
+    BOOST_CHECK(c.compare(a) > 0);
+
+    key_type empty;
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(0, empty.id());
+    BOOST_CHECK(empty == key_type(s1.data(), size_t(0)));
+}
+
+BOOST_AUTO_TEST_CASE(test_interned_json)
+{
+    std::string s = R"(
+    [
+        {"id" : 1, "customer_name" : "Smith", "items" : [{"sku" : "a", "quantity" : 2}]},
+        {"customer_name" : "Jones", "id" : 2, "items" : []}
+    ]
+    )";
+
+    interned_json j = interned_json::parse(s);
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), j.to_string());
+    BOOST_CHECK(j[0].object_range().begin()->key().data() == j[1].object_range().begin()->key().data());
+    BOOST_CHECK_EQUAL(std::string("Jones"), j[1]["customer_name"].as<std::string>());
+
+    j[1]["status"] = "shipped";
+    j[1].insert_or_assign("id", 3);
+    BOOST_CHECK(j[1].has_key("status"));
+    BOOST_CHECK_EQUAL(3, j[1]["id"].as<int>());
+    j[1].erase("status");
+    BOOST_CHECK_EQUAL(3, j[1].size());
+
+    interned_ojson o = interned_ojson::parse(s);
+    BOOST_CHECK_EQUAL(ojson::parse(s).to_string(), o.to_string());
+    BOOST_CHECK_EQUAL(std::string("customer_name"), std::string(o[1].object_range().begin()->key()));
+
+    interned_wjson w = interned_wjson::parse(L"{\"k\":[\"v\"]}");
+    BOOST_CHECK(w[L"k"][0].as<std::wstring>() == L"v");
+}
+
+BOOST_AUTO_TEST_CASE(test_interned_json_record_shapes)
+{
+    // Records whose names match, differ in order, grow, shrink or nest the same names
+    std::string s = R"(
+    [
+        {"a" : 1, "b" : {"a" : 1, "c" : 2}, "c" : 3},
+        {"a" : 4, "b" : {"a" : 5, "c" : 6}, "c" : 7},
+        {"a" : 8, "b" : {"c" : 9, "a" : 10}, "c" : 11, "d" : 12},
+        {"a" : 13, "b" : {}},
+        {"c" : 14, "a" : 15, "b" : {"a" : 16, "c" : 17, "a" : 18}},
+        {"a" : 19, "b" : [{"a" : 20}, {"a" : 21, "b" : 22}], "c" : 23},
+        {}
+    ]
+    )";
+
+    interned_json j = interned_json::parse(s);
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), j.to_string());
+    BOOST_CHECK(j[0].object_range().begin()->key().data() == j[1].object_range().begin()->key().data());
+    BOOST_CHECK_EQUAL(12, j[2]["d"].as<int>());
+
+    interned_ojson o = interned_ojson::parse(s);
+    BOOST_CHECK_EQUAL(ojson::parse(s).to_string(), o.to_string());
+    BOOST_CHECK_EQUAL(std::string("c"), std::string(o[2]["b"].object_range().begin()->key()));
+}
+
+// An interned_key that counts how many times it is made from characters, rather than copied
+template <class CharT, class CharTraits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+class counted_key : public interned_key<CharT,CharTraits,Allocator>
+{
+    typedef interned_key<CharT,CharTraits,Allocator> base_type;
+public:
+    static size_t& from_chars()
+    {
+        static size_t count = 0;
+        return count;
+    }
+
+    counted_key() = default;
+
+    counted_key(const CharT* s, size_t length)
+        : base_type(s, length)
+    {
+        ++from_chars();
+    }
+
+    counted_key(const CharT* first, const CharT* last)
+        : base_type(first, last)
+    {
+        ++from_chars();
+    }
+
+    template <class A>
+    counted_key(const CharT* first, const CharT* last, const A& allocator)
+        : base_type(first, last, allocator)
+    {
+        ++from_chars();
+    }
+
+    explicit counted_key(const typename base_type::string_view_type& s)
+        : base_type(s)
+    {
+        ++from_chars();
+    }
+};
+
+struct counted_key_policy : public sorted_policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = counted_key<CharT, CharTraits, Allocator>;
+};
+
+BOOST_AUTO_TEST_CASE(test_decoder_reuses_record_keys)
+{
+    typedef basic_json<char,counted_key_policy> counted_json;
+
+    // Records with the same names take their keys from the record before, so only the
+    // first record's names are looked up, and a record that differs is looked up again
+    std::string s = "[";
+    for (size_t i = 0; i < 100; ++i)
+    {
+        s += R"({"id":)" + std::to_string(i) + R"(,"name":"n","tags":{"x":1,"y":2}},)";
+    }
+    s += R"({"id":100,"other":0}])";
+
+    counted_key<char>::from_chars() = 0;
+    counted_json j = counted_json::parse(s);
+    BOOST_CHECK_EQUAL(5 + 1, counted_key<char>::from_chars());
+
+    BOOST_CHECK_EQUAL(101, j.size());
+    BOOST_CHECK_EQUAL(99, j[99]["id"].as<int>());
+    BOOST_CHECK_EQUAL(0, j[100]["other"].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_interned_key_threads)
+{
+    std::vector<std::thread> threads;
+    std::vector<std::vector<interned_key<char>>> keys(4);
+    for (size_t t = 0; t < keys.size(); ++t)
+    {
+        threads.emplace_back([&keys,t]()
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                std::string name = "interned_key_threads_" + std::to_string(i);
+                keys[t].emplace_back(name.data(), name.length());
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        BOOST_CHECK(keys[0][i] == keys[1][i]);
+        BOOST_CHECK(keys[0][i] == keys[2][i]);
+        BOOST_CHECK(keys[0][i] == keys[3][i]);
+        BOOST_CHECK_EQUAL("interned_key_threads_" + std::to_string(i), std::string(keys[3][i].data()));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -343,5 +343,94 @@ BOOST_AUTO_TEST_CASE(test_from_container)
     BOOST_CHECK_CLOSE(val2[2].as<double>(),30.5,0.000001);
 }
 
+// Packing is turned on by the implementation policy
+struct packing_policy : public sorted_policy
+{
+    static const size_t packed_array_threshold = 16;
+};
+
+typedef basic_json<char,packing_policy> packed_json;
+
+BOOST_AUTO_TEST_CASE(test_packed_array_off_by_default)
+{
+    std::vector<double> v(100, 0.5);
+    json j = v;
+    BOOST_CHECK(j.array_value().packing() == packed_kind::none);
+    BOOST_CHECK(j.as<std::vector<double>>() == v);
+
+    json k = json::parse("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]");
+    BOOST_CHECK(k.array_value().packing() == packed_kind::none);
+
+    // Arrays of a policy without packing have no packed state
+    BOOST_CHECK(sizeof(json::array) < sizeof(packed_json::array));
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_array_from_vector)
+{
+    std::vector<double> v;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        v.push_back(i * 0.25);
+    }
+    packed_json j = v;
+    BOOST_CHECK(j.array_value().packing() == packed_kind::floating);
+    BOOST_CHECK(j.array_value().packed_data<double>() != nullptr);
+    BOOST_CHECK(j.is<std::vector<double>>());
+    BOOST_CHECK(j.as<std::vector<double>>() == v);
+    BOOST_CHECK_EQUAL(100, j.size());
+
+    std::vector<int64_t> w = {-1, 2, -3, 4, -5, 6, -7, 8, -9, 10, -11, 12, -13, 14, -15, 16};
+    packed_json k = w;
+    BOOST_CHECK(k.array_value().packing() == packed_kind::integer);
+    BOOST_CHECK(k.as<std::vector<int64_t>>() == w);
+    BOOST_CHECK_EQUAL(-15, k[14].as<int>());
+
+    std::vector<uint64_t> u(3, 7);
+    packed_json small = u;
+    BOOST_CHECK(small.array_value().packing() == packed_kind::none);
+    BOOST_CHECK(small.as<std::vector<uint64_t>>() == u);
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_array_parse)
+{
+    std::string s = "[1.5,2.25,3.125,4.0,5.5,6.25,7.125,8.0,9.5,10.25,11.125,12.0,13.5,14.25,15.125,16.0,0.10000000000000001]";
+    packed_json j = packed_json::parse(s);
+    BOOST_CHECK(j.array_value().packing() == packed_kind::floating);
+    BOOST_CHECK_EQUAL(s, j.to_string());
+
+    packed_json ints = packed_json::parse("[[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16],[-1,2,-3,4,-5,6,-7,8,-9,10,-11,12,-13,14,-15,16]]");
+    BOOST_CHECK(ints[0].array_value().packing() == packed_kind::uinteger);
+    BOOST_CHECK(ints[1].array_value().packing() == packed_kind::none);
+
+    packed_json mixed = packed_json::parse("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16.5]");
+    BOOST_CHECK(mixed.array_value().packing() == packed_kind::none);
+    BOOST_CHECK_EQUAL(packed_json::parse("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16.5]"), mixed);
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_array_fallback)
+{
+    packed_json j = packed_json::parse("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]");
+    packed_json copy = j;
+    BOOST_CHECK(copy.array_value().packing() == packed_kind::uinteger);
+    BOOST_CHECK_EQUAL(j, copy);
+
+    j.push_back(uint64_t(17));
+    BOOST_CHECK(j.array_value().packing() == packed_kind::uinteger);
+    BOOST_CHECK_EQUAL(17, j.size());
+
+    const packed_json& cj = j;
+    BOOST_CHECK_EQUAL(3, cj[2].as<int>());
+    BOOST_CHECK(j.array_value().packing() == packed_kind::uinteger);
+
+    j.push_back("eighteen");
+    BOOST_CHECK(j.array_value().packing() == packed_kind::none);
+    BOOST_CHECK_EQUAL(std::string("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,\"eighteen\"]"), j.to_string());
+
+    copy[0] = "zero";
+    BOOST_CHECK(copy.array_value().packing() == packed_kind::none);
+    BOOST_CHECK_EQUAL(std::string("zero"), copy[0].as<std::string>());
+    BOOST_CHECK_EQUAL(16, copy[15].as<int>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,168 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_cursor_tests)
+
+BOOST_AUTO_TEST_CASE(test_cursor_events)
+{
+    std::string s = R"({"a":[1,-2,3.5],"b":"été","c":true,"d":null,"e":{}})";
+
+    json_cursor cursor(s);
+
+    std::vector<json_event_type> types;
+    for (; !cursor.done(); cursor.next())
+    {
+        types.push_back(cursor.current().event_type());
+    }
+    std::vector<json_event_type> expected = {
+        json_event_type::begin_object,
+        json_event_type::name, json_event_type::begin_array,
+        json_event_type::uinteger_value, json_event_type::integer_value, json_event_type::double_value,
+        json_event_type::end_array,
+        json_event_type::name, json_event_type::string_value,
+        json_event_type::name, json_event_type::bool_value,
+        json_event_type::name, json_event_type::null_value,
+        json_event_type::name, json_event_type::begin_object, json_event_type::end_object,
+        json_event_type::end_object
+    };
+    BOOST_CHECK(types == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_values)
+{
+    std::string s = R"([10,-20,2.5,"x\ty",false])";
+
+    json_cursor cursor(s);
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::begin_array);
+    cursor.next();
+    BOOST_CHECK_EQUAL(10, cursor.current().as_integer());
+    cursor.next();
+    BOOST_CHECK_EQUAL(-20, cursor.current().as_integer());
+    cursor.next();
+    BOOST_CHECK_EQUAL(2.5, cursor.current().as_double());
+    cursor.next();
+    BOOST_CHECK_EQUAL(std::string("x\ty"), cursor.current().as_string());
+    cursor.next();
+    BOOST_CHECK_EQUAL(false, cursor.current().as_bool());
+    cursor.next();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::end_array);
+    cursor.next();
+    BOOST_CHECK(cursor.done());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_string_views_into_source)
+{
+    std::string s = R"({"name":"value","escaped":"a\nb"})";
+
+    json_cursor cursor(s);
+    cursor.next();
+    BOOST_CHECK(cursor.current().as_string_view().data() == s.data() + 2);
+    cursor.next();
+    BOOST_CHECK(cursor.current().as_string_view().data() == s.data() + 9);
+    cursor.next();
+    cursor.next();
+    // Unescaped into the parser's string buffer, still valid after the parser has stopped
+    BOOST_CHECK_EQUAL(std::string("a\nb"), cursor.current().as_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_skip_subtree)
+{
+    std::string s = R"({"skip":{"a":[1,2,{"b":3}],"c":4},"keep":5,"last":[6]})";
+
+    json_cursor cursor(s);
+    cursor.next();
+    BOOST_CHECK_EQUAL(std::string("skip"), cursor.current().as_string());
+    cursor.next();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::begin_object);
+    cursor.skip_subtree();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::end_object);
+    cursor.next();
+    BOOST_CHECK_EQUAL(std::string("keep"), cursor.current().as_string());
+    cursor.next();
+    BOOST_CHECK_EQUAL(5, cursor.current().as_integer());
+    cursor.next();
+    cursor.next();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::begin_array);
+    cursor.skip_subtree();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::end_array);
+    cursor.next();
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::end_object);
+    cursor.next();
+    BOOST_CHECK(cursor.done());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_stream_across_buffers)
+{
+    std::string s = "[";
+    for (int i = 0; i < 3000; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(",");
+        }
+        s.append("{\"id\":" + std::to_string(i) + ",\"name\":\"n\\t" + std::to_string(i) + "\"}");
+    }
+    s.append("]");
+    std::istringstream is(s);
+    json_cursor cursor(is);
+
+    size_t count = 0;
+    int64_t sum = 0;
+    size_t names = 0;
+    for (; !cursor.done(); cursor.next())
+    {
+        const auto& event = cursor.current();
+        if (event.event_type() == json_event_type::integer_value || event.event_type() == json_event_type::uinteger_value)
+        {
+            sum += event.as_integer();
+        }
+        else if (event.event_type() == json_event_type::string_value)
+        {
+            BOOST_CHECK(event.as_string_view().substr(0,2) == "n\t");
+            ++names;
+        }
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(2 + 3000*6, count);
+    BOOST_CHECK_EQUAL(3000*2999/2, sum);
+    BOOST_CHECK_EQUAL(3000, names);
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_scalar)
+{
+    std::string s = "  123  ";
+
+    json_cursor cursor(s);
+    BOOST_CHECK(!cursor.done());
+    BOOST_CHECK_EQUAL(123, cursor.current().as_integer());
+    cursor.next();
+    BOOST_CHECK(cursor.done());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_error)
+{
+    std::string s = R"([1,2,})";
+
+    json_cursor cursor(s);
+    cursor.next();
+    cursor.next();
+    std::error_code ec;
+    cursor.next(ec);
+    BOOST_CHECK(ec);
+
+    std::string s2 = R"({"a" 1})";
+    json_cursor cursor2(s2);
+    cursor2.next();
+    BOOST_CHECK_THROW(cursor2.next(), parse_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
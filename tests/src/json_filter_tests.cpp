@@ -11,6 +11,8 @@
 #include <utility>
 #include <ctime>
 #include <new>
+#include <algorithm>
+#include <cctype>
 #include <jsoncons/json_serializer.hpp>
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/json_reader.hpp>
@@ -171,4 +173,37 @@ BOOST_AUTO_TEST_CASE(test_chained_filters)
     BOOST_CHECK(j2["fourth"] == 4);
 }
 
+BOOST_AUTO_TEST_CASE(test_filter_subclass_events)
+{
+    // Events called on a subclass reach its overrides, however they are called
+    class upper_name_filter : public json_filter
+    {
+    public:
+        upper_name_filter(json_input_handler& handler)
+            : json_filter(handler)
+        {
+        }
+    private:
+        void do_name(const string_view_type& name, const parsing_context& context) override
+        {
+            std::string s(name.begin(), name.end());
+            std::transform(s.begin(), s.end(), s.begin(), ::toupper);
+            this->downstream_handler().name(s, context);
+        }
+    };
+
+    json_decoder<json> decoder;
+    upper_name_filter filter(decoder);
+    json::parse(R"({"a":1})").dump(filter);
+    BOOST_CHECK_EQUAL(json::parse(R"({"A":1})"), decoder.get_result());
+
+    std::string s = R"({"b":[2]})";
+    json_parser parser(filter);
+    parser.set_source(s.data(), s.length());
+    parser.parse();
+    parser.end_parse();
+    parser.check_done();
+    BOOST_CHECK_EQUAL(json::parse(R"({"B":[2]})"), decoder.get_result());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,154 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_lines_reader_tests)
+
+static std::string make_json_lines(size_t count)
+{
+    std::string s;
+    for (size_t i = 0; i < count; ++i)
+    {
+        s.append("{\"id\":" + std::to_string(i) + ",\"name\":\"record " + std::to_string(i) + "\",\"tags\":[1,2,3]}");
+        s.append(i % 7 == 0 ? "\r\n" : "\n");
+        if (i % 100 == 0)
+        {
+            s.append("  \n");
+        }
+    }
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_ordered)
+{
+    std::string s = make_json_lines(5000);
+
+    json_lines_reader<json> reader(s);
+    reader.num_threads(4);
+    reader.chunk_length(1000);
+
+    std::vector<json> values;
+    reader.read([&](json&& val){values.push_back(std::move(val));});
+
+    BOOST_REQUIRE_EQUAL(5000, values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(i, values[i]["id"].as<size_t>());
+    }
+    BOOST_CHECK_EQUAL(std::string("record 4999"), values.back()["name"].as<std::string>());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_unordered)
+{
+    std::string s = make_json_lines(5000);
+
+    json_lines_reader<json> reader(s);
+    reader.num_threads(3);
+    reader.chunk_length(512);
+    reader.ordered(false);
+
+    std::vector<size_t> ids;
+    reader.read([&](json&& val){ids.push_back(val["id"].as<size_t>());});
+
+    BOOST_REQUIRE_EQUAL(5000, ids.size());
+    std::sort(ids.begin(), ids.end());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(i, ids[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_stream)
+{
+    std::string s = "\xEF\xBB\xBF" + make_json_lines(2000);
+    std::istringstream is(s);
+
+    json_lines_reader<json> reader(is);
+    reader.num_threads(2);
+    reader.chunk_length(300);
+
+    size_t count = 0;
+    reader.read([&](json&& val)
+    {
+        BOOST_CHECK_EQUAL(count, val["id"].as<size_t>());
+        ++count;
+    });
+    BOOST_CHECK_EQUAL(2000, count);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_scalars_and_last_line)
+{
+    std::string s = "1\n\"two\"\n[3]\nnull";
+
+    json_lines_reader<json> reader(s);
+    std::vector<json> values;
+    reader.read([&](json&& val){values.push_back(std::move(val));});
+
+    BOOST_REQUIRE_EQUAL(4, values.size());
+    BOOST_CHECK_EQUAL(1, values[0].as<int>());
+    BOOST_CHECK_EQUAL(std::string("two"), values[1].as<std::string>());
+    BOOST_CHECK_EQUAL(3, values[2][0].as<int>());
+    BOOST_CHECK(values[3].is_null());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_error_line)
+{
+    std::string s = make_json_lines(1000);
+    // Insert a bad line as line 1000
+    size_t pos = 0;
+    size_t records = 0;
+    for (size_t line = 1; line < 1000; ++line)
+    {
+        if (s[pos] == '{')
+        {
+            ++records;
+        }
+        pos = s.find('\n', pos) + 1;
+    }
+    s.insert(pos, "{\"a\" 1}\n");
+
+    json_lines_reader<json> reader(s);
+    reader.num_threads(4);
+    reader.chunk_length(256);
+
+    size_t count = 0;
+    try
+    {
+        reader.read([&](json&&){++count;});
+        BOOST_CHECK(false);
+    }
+    catch (const parse_error& e)
+    {
+        BOOST_CHECK(e.code() == json_parser_errc::expected_colon);
+        BOOST_CHECK_EQUAL(1000, e.line_number());
+        BOOST_CHECK_EQUAL(6, e.column_number());
+    }
+    BOOST_CHECK_EQUAL(records, count);
+
+    std::error_code ec;
+    std::string s2 = "{}\n{]\n";
+    json_lines_reader<json> reader2(s2);
+    reader2.read([](json&&){}, ec);
+    BOOST_CHECK(ec);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_lines_two_values_on_one_line)
+{
+    std::string s = "{\"a\":1}\n{\"b\":2} {\"c\":3}\n";
+
+    json_lines_reader<json> reader(s);
+    std::error_code ec;
+    reader.read([](json&&){}, ec);
+    BOOST_CHECK(ec == json_parser_errc::extra_character);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
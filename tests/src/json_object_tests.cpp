@@ -9,11 +9,19 @@
 #include <utility>
 #include <ctime>
 #include <map>
+#include <thread>
 
 using namespace jsoncons;
 
 BOOST_AUTO_TEST_SUITE(json_object_tests)
 
+struct buffered_policy : public sorted_policy
+{
+    static const size_t object_append_buffer_threshold = 256;
+};
+
+typedef basic_json<char,buffered_policy> buffered_json;
+
 BOOST_AUTO_TEST_CASE(as_test)
 {
     json j;
@@ -1193,5 +1201,194 @@ ojson expected = ojson::parse(R"(
     //std::cout << "(2)\n" << source << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_json_object_key_prefixes)
+{
+    // Keys that share their first eight characters tie on prefix
+    std::map<std::string,int> expected;
+    json j;
+    for (int i = 0; i < 300; ++i)
+    {
+        std::string key = (i % 3 == 0 ? "shared_prefix_" : "k") + std::to_string(i);
+        j.insert_or_assign(key, i);
+        expected[key] = i;
+    }
+    expected[""] = -1;
+    j[""] = -1;
+    expected[std::string("\xc3\xa9t\xc3\xa9")] = -2;
+    j[std::string("\xc3\xa9t\xc3\xa9")] = -2;
+    BOOST_CHECK(j.object_value().has_key_prefixes());
+
+    for (int i = 0; i < 300; i += 7)
+    {
+        std::string key = (i % 3 == 0 ? "shared_prefix_" : "k") + std::to_string(i);
+        j.erase(key);
+        expected.erase(key);
+    }
+
+    BOOST_REQUIRE_EQUAL(expected.size(), j.size());
+    auto it = expected.begin();
+    for (const auto& member : j.object_range())
+    {
+        BOOST_CHECK_EQUAL(it->first, std::string(member.key()));
+        BOOST_CHECK_EQUAL(it->second, j.at(it->first).as<int>());
+        BOOST_CHECK_EQUAL(1, j.count(it->first));
+        ++it;
+    }
+    BOOST_CHECK_EQUAL(0, j.count("shared_prefix_0"));
+    BOOST_CHECK_EQUAL(0, j.count("shared_prefix_"));
+    BOOST_CHECK_EQUAL(0, j.count("k"));
+    BOOST_CHECK(j.find("zzz") == j.object_range().end());
+
+    json copy = json::parse(j.to_string());
+    BOOST_CHECK(copy.object_value().has_key_prefixes());
+    BOOST_CHECK_EQUAL(j, copy);
+
+    while (j.size() > 10)
+    {
+        j.erase(j.object_range().begin()->key());
+    }
+    BOOST_CHECK(!j.object_value().has_key_prefixes());
+    BOOST_CHECK_EQUAL(expected.rbegin()->second, j[expected.rbegin()->first].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_wjson_object_key_prefixes)
+{
+    wjson j;
+    for (int i = 0; i < 100; ++i)
+    {
+        j.insert_or_assign(L"key" + std::to_wstring(i), i);
+    }
+    j[std::wstring(1, static_cast<wchar_t>(0x10FFFF))] = 100;
+    j[L"é"] = 101;
+    BOOST_CHECK(j.object_value().has_key_prefixes());
+    for (int i = 0; i < 100; ++i)
+    {
+        BOOST_CHECK_EQUAL(i, j.at(L"key" + std::to_wstring(i)).as<int>());
+    }
+    BOOST_CHECK_EQUAL(100, j.at(std::wstring(1, static_cast<wchar_t>(0x10FFFF))).as<int>());
+    BOOST_CHECK_EQUAL(101, j.at(L"é").as<int>());
+    BOOST_CHECK(j.find(L"key") == j.object_range().end());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_object_append_buffer)
+{
+    std::map<std::string,int> expected;
+    buffered_json j;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string key = "id" + std::to_string((i*7919) % 1000);
+        j.try_emplace(key, i);
+        expected.emplace(key, i);
+    }
+    // Members inserted out of order are appended, and merged in when looked up
+    BOOST_CHECK(j.object_value().appended_size() > 0);
+    j.insert_or_assign("id7", -7);
+    expected["id7"] = -7;
+    j["id8"] = -8;
+    expected["id8"] = -8;
+    j.erase("id9");
+    expected.erase("id9");
+    BOOST_CHECK(j.object_value().appended_size() > 0);
+
+    BOOST_REQUIRE_EQUAL(expected.size(), j.size());
+    auto it = expected.begin();
+    for (const auto& member : j.object_range())
+    {
+        BOOST_CHECK_EQUAL(it->first, std::string(member.key()));
+        BOOST_CHECK_EQUAL(it->second, member.value().as<int>());
+        ++it;
+    }
+    BOOST_CHECK_EQUAL(0, j.object_value().appended_size());
+    BOOST_CHECK(j.object_value().has_key_prefixes());
+
+    j.try_emplace("id5000", 1);
+    const buffered_json copy(j);
+    BOOST_CHECK_EQUAL(0, copy.object_value().appended_size());
+    BOOST_CHECK_EQUAL(j, copy);
+    BOOST_CHECK_EQUAL(1, copy.count("id5000"));
+
+    // Without the buffer, the default
+    json u;
+    for (const auto& item : expected)
+    {
+        u.try_emplace(item.first, item.second);
+    }
+    BOOST_CHECK_EQUAL(0, u.object_value().appended_size());
+    BOOST_CHECK(sizeof(json::object) < sizeof(buffered_json::object));
+    j.erase("id5000");
+    BOOST_CHECK_EQUAL(j.to_string(), u.to_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_object_append_buffer_concurrent_readers)
+{
+    buffered_json j;
+    for (int i = 0; i < 1000; ++i)
+    {
+        j.try_emplace("id" + std::to_string((i*7919) % 1000), i);
+    }
+    BOOST_REQUIRE(j.object_value().appended_size() > 0);
+
+    // The first lookup merges, and the others see the result
+    const buffered_json& cj = j;
+    std::vector<std::thread> threads;
+    std::vector<int> found(4, 0);
+    for (size_t t = 0; t < found.size(); ++t)
+    {
+        threads.emplace_back([&cj,&found,t]()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                found[t] += cj.count("id" + std::to_string(i)) == 1 ? 1 : 0;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (int count : found)
+    {
+        BOOST_CHECK_EQUAL(1000, count);
+    }
+}
+
+// A policy written without the tuning constants of sorted_policy
+struct standalone_policy
+{
+    static const bool preserve_order = false;
+
+    template <class T,class Allocator>
+    using object_storage = std::vector<T,Allocator>;
+
+    template <class T,class Allocator>
+    using array_storage = std::vector<T,Allocator>;
+
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = std::basic_string<CharT, CharTraits,Allocator>;
+
+    template <class CharT, class CharTraits, class Allocator>
+    using string_storage = std::basic_string<CharT, CharTraits,Allocator>;
+
+    typedef default_parse_error_handler parse_error_handler_type;
+};
+
+BOOST_AUTO_TEST_CASE(test_policy_without_tuning_constants)
+{
+    typedef basic_json<char,standalone_policy> standalone_json;
+
+    standalone_json j;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        j.insert_or_assign("key" + std::to_string(1000 - i), i);
+    }
+    j["array"] = standalone_json::parse("[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17]");
+
+    BOOST_CHECK_EQUAL(301, j.size());
+    BOOST_CHECK_EQUAL(299, j.at("key701").as<size_t>());
+    BOOST_CHECK_EQUAL(17, j["array"].size());
+    BOOST_CHECK_EQUAL("array", j.object_range().begin()->key());
+    BOOST_CHECK_EQUAL("key1000", (j.object_range().begin()+1)->key());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
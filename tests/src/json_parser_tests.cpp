@@ -254,8 +254,57 @@ BOOST_AUTO_TEST_CASE(test_array_string)
     json j = decoder.get_result();
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(test_long_whitespace_runs)
+{
+    std::string s = "[1,\r\n                                \t\t\t\t2,\n\n\r                    3\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t]                        ";
+
+    json j1 = json::parse(s);
+    BOOST_REQUIRE(j1.is_array());
+    BOOST_REQUIRE_EQUAL(3,j1.size());
+    BOOST_CHECK_EQUAL(3,j1[2].as<int>());
+
+    // One character at a time, so that every run is split across chunks
+    jsoncons::json_decoder<json> decoder;
+    json_parser parser(decoder);
+    parser.reset();
+    for (size_t i = 0; i < s.length() && !parser.done(); ++i)
+    {
+        parser.set_source(s.data()+i,1);
+        parser.parse();
+    }
+    BOOST_CHECK(parser.done());
+    parser.end_parse();
+    BOOST_CHECK(decoder.get_result() == j1);
+}
 
+BOOST_AUTO_TEST_CASE(test_whitespace_line_and_column)
+{
+    std::string s = "{\r\n    \"a\" : 1,\n\r\n                        x}";
+
+    try
+    {
+        json::parse(s);
+        BOOST_FAIL("Expected parse_error");
+    }
+    catch (const parse_error& e)
+    {
+        BOOST_CHECK_EQUAL(4,e.line_number());
+        BOOST_CHECK_EQUAL(25,e.column_number());
+    }
+}
 
+BOOST_AUTO_TEST_CASE(test_parser_with_static_decoder)
+{
+    std::string s = R"({"a":[1,-2,3.5,"four",true,null],"b":{"c":18446744073709551615}})";
 
+    static_json_decoder<json> decoder;
+    basic_json_parser<char,std::allocator<char>,static_json_decoder<json>> parser(decoder);
+    parser.set_source(s.data(), s.length());
+    parser.parse();
+    parser.end_parse();
+    parser.check_done();
+    BOOST_REQUIRE(decoder.is_valid());
+    BOOST_CHECK_EQUAL(json::parse(s), decoder.get_result());
+}
 
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reclaimer.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_reclaimer_tests)
+
+BOOST_AUTO_TEST_CASE(test_destroy_deeply_nested)
+{
+    // Deep enough to overflow the stack if destruction recursed once per level
+    json j = json::array();
+    for (size_t i = 0; i < 1000000; ++i)
+    {
+        json k = (i % 2 == 0) ? json(json::object()) : json(json::array());
+        if (k.is_object())
+        {
+            k["a"] = std::move(j);
+            k["b"] = "a string long enough to be allocated on the heap";
+        }
+        else
+        {
+            k.push_back(std::move(j));
+            k.push_back(json::parse("[1,2,3]"));
+        }
+        j = std::move(k);
+    }
+    BOOST_CHECK(j.is_array());
+    j = json::null();
+    BOOST_CHECK(j.is_null());
+}
+
+BOOST_AUTO_TEST_CASE(test_destroy_nested_values)
+{
+    json j = json::parse(R"(
+    {
+        "a" : [1, [2, [3, {"b" : [4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]}]]],
+        "c" : {"d" : {}, "e" : []},
+        "f" : "a string long enough to be allocated on the heap"
+    }
+    )");
+    json copy = j;
+    BOOST_CHECK_EQUAL(j, copy);
+    copy = json::null();
+    BOOST_CHECK_EQUAL(19, j["a"][1][1][1]["b"][15].as<int>());
+}
+
+struct buffered_policy : public sorted_policy
+{
+    static const size_t object_append_buffer_threshold = 256;
+};
+
+BOOST_AUTO_TEST_CASE(test_destroy_unmerged_members)
+{
+    // Objects with nested members still appended, unsorted, are destroyed as they are
+    typedef basic_json<char,buffered_policy> buffered_json;
+
+    buffered_json j = buffered_json::array();
+    for (size_t n = 0; n < 3; ++n)
+    {
+        buffered_json o;
+        for (size_t i = 0; i < 300; ++i)
+        {
+            o.try_emplace("key" + std::to_string((i*7919) % 300), buffered_json::array({i, buffered_json::object()}));
+        }
+        BOOST_CHECK(o.object_value().appended_size() > 0);
+        j.push_back(std::move(o));
+    }
+    j[0]["key1"][1]["inner"] = std::move(j[1]);
+    BOOST_CHECK(j[2].object_value().appended_size() > 0);
+    j = buffered_json::null();
+    BOOST_CHECK(j.is_null());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_reclaimer)
+{
+    json_reclaimer reclaimer;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        json j = json::array();
+        for (size_t k = 0; k < 1000; ++k)
+        {
+            j.push_back(json::parse(R"({"name" : "a name that is too long to be stored inline", "values" : [1, 2.5]})"));
+        }
+        reclaimer.reclaim(std::move(j));
+        BOOST_CHECK(j.is_null());
+    }
+    reclaimer.flush();
+
+    ojson_reclaimer ojson_reclaimer;
+    ojson o = ojson::parse(R"({"b" : [1, 2], "a" : {"c" : null}})");
+    ojson_reclaimer.reclaim(std::move(o));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -214,6 +214,22 @@ BOOST_AUTO_TEST_CASE(test_serialization_1)
     BOOST_CHECK_EQUAL(expected7,os7.str());
 }
 
+BOOST_AUTO_TEST_CASE(test_escape_string_runs)
+{
+    std::string plain = "abcdefghijklmnopqrstuvwxyz0123456789";
+    std::string s = plain + "\"" + plain + "\\" + plain + "/" + plain + "\n\x7f" + plain + "caf\xC3\xA9" + plain;
+    json j(s);
+
+    std::string expected = "\"" + plain + "\\\"" + plain + "\\\\" + plain + "/" + plain + "\\n\\u007F" + plain + "caf\xC3\xA9" + plain + "\"";
+    BOOST_CHECK_EQUAL(expected, j.to_string());
+
+    serialization_options options;
+    options.escape_solidus(true);
+    options.escape_all_non_ascii(true);
+    std::string expected2 = "\"" + plain + "\\\"" + plain + "\\\\" + plain + "\\/" + plain + "\\n\\u007F" + plain + "caf\\u00E9" + plain + "\"";
+    BOOST_CHECK_EQUAL(expected2, j.to_string(options));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,146 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_tape.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_tape_tests)
+
+BOOST_AUTO_TEST_CASE(test_json_tape_access)
+{
+    std::string s = R"(
+    {
+        "name" : "Smith",
+        "age" : 42,
+        "balance" : -17,
+        "ratio" : 0.25,
+        "big" : 18446744073709551615,
+        "active" : true,
+        "spouse" : null,
+        "children" : [{"name":"Anne","age":7},{"name":"Bob","age":5}],
+        "empty" : {}
+    }
+    )";
+
+    json_tape tape = json_tape::parse(s);
+    json_tape_view root = tape.root();
+
+    BOOST_REQUIRE(root.is_object());
+    BOOST_CHECK_EQUAL(9, root.size());
+    BOOST_CHECK(root.at("name").as_string_view() == "Smith");
+    BOOST_CHECK_EQUAL(std::string("Smith"), root["name"].as<std::string>());
+    BOOST_CHECK_EQUAL(42, root.at("age").as<int>());
+    BOOST_CHECK_EQUAL(-17, root.at("balance").as<int64_t>());
+    BOOST_CHECK_EQUAL(0.25, root.at("ratio").as<double>());
+    BOOST_CHECK_EQUAL(18446744073709551615ULL, root.at("big").as<uint64_t>());
+    BOOST_CHECK(root.at("active").as<bool>());
+    BOOST_CHECK(root.at("spouse").is_null());
+    BOOST_CHECK(root.at("empty").is_object());
+    BOOST_CHECK(root.at("empty").empty());
+
+    json_tape_view children = root.at("children");
+    BOOST_REQUIRE(children.is_array());
+    BOOST_CHECK_EQUAL(2, children.size());
+    BOOST_CHECK(children.at(1).at("name").as_string_view() == "Bob");
+    BOOST_CHECK_EQUAL(5, children[1]["age"].as<int>());
+
+    BOOST_CHECK(root.find("missing") == root.object_range().end());
+    BOOST_CHECK_EQUAL(1, root.count("ratio"));
+    BOOST_CHECK_THROW(root.at("missing"), key_not_found);
+    BOOST_CHECK_THROW(children.at(2), std::out_of_range);
+    BOOST_CHECK_THROW(root.at("age").as_string_view(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_tape_iteration)
+{
+    json_tape tape = json_tape::parse(R"({"a":[1,[2,3],{"x":4}],"b":"text","c":[]})");
+    json_tape_view root = tape.root();
+
+    std::vector<std::string> keys;
+    for (const auto& member : root.object_range())
+    {
+        keys.push_back(std::string(member.key().data(), member.key().length()));
+    }
+    BOOST_REQUIRE_EQUAL(3, keys.size());
+    BOOST_CHECK_EQUAL(std::string("a"), keys[0]);
+    BOOST_CHECK_EQUAL(std::string("b"), keys[1]);
+    BOOST_CHECK_EQUAL(std::string("c"), keys[2]);
+
+    size_t count = 0;
+    for (const auto& element : root.at("a").array_range())
+    {
+        BOOST_CHECK(count != 0 || element.as<int>() == 1);
+        BOOST_CHECK(count != 1 || element.size() == 2);
+        BOOST_CHECK(count != 2 || element.at("x").as<int>() == 4);
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(3, count);
+    BOOST_CHECK(root.at("c").array_range().begin() == root.at("c").array_range().end());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_tape_to_json)
+{
+    std::string s = R"({"a":[1,2.5,-3,"four",null,false],"b":{"c":{"d":"e"}},"f":1.10})";
+    json expected = json::parse(s);
+
+    json_tape tape = json_tape::parse(s);
+    BOOST_CHECK_EQUAL(expected, tape.root().to_json<json>());
+    BOOST_CHECK_EQUAL(expected["b"], tape.root().at("b").to_json<json>());
+    BOOST_CHECK_EQUAL(expected["a"], tape.root().at("a").as<json>());
+
+    // Writes the same text as the json value
+    std::ostringstream os;
+    json_serializer serializer(os);
+    tape.root().dump(serializer);
+    std::ostringstream expected_os;
+    expected_os << expected;
+    BOOST_CHECK_EQUAL(expected_os.str(), os.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_tape_stream)
+{
+    std::string s = "[";
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(",");
+        }
+        s.append("{\"id\":" + std::to_string(i) + ",\"tags\":[\"x\",\"y\"]}");
+    }
+    s.append("]");
+    std::istringstream is(s);
+
+    json_tape tape = json_tape::parse(is);
+    json_tape_view root = tape.root();
+    BOOST_CHECK_EQUAL(5000, root.size());
+    BOOST_CHECK_EQUAL(4999, root.at(4999).at("id").as<size_t>());
+    BOOST_CHECK_EQUAL(json::parse(s), root.to_json<json>());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_tape_scalar_and_errors)
+{
+    json_tape tape = json_tape::parse("\"abc\"");
+    BOOST_CHECK(tape.root().as_string_view() == "abc");
+
+    json_tape empty;
+    BOOST_CHECK(empty.root().is_null());
+
+    BOOST_CHECK_THROW(json_tape::parse("{\"a\":1"), parse_error);
+    BOOST_CHECK_THROW(json_tape::parse("[1,2]]"), parse_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_wjson_tape)
+{
+    wjson_tape tape = wjson_tape::parse(L"{\"k\":[\"v\"]}");
+    BOOST_CHECK(tape.root().at(L"k").at(0).as_string_view() == L"v");
+    BOOST_CHECK(tape.root().to_json<wjson>() == wjson::parse(L"{\"k\":[\"v\"]}"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/mapped_file.hpp>
+#include <sstream>
+#include <fstream>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(mapped_file_tests)
+
+BOOST_AUTO_TEST_CASE(test_mapped_file_contents)
+{
+    std::string in_file = "./input/address-book.json";
+    std::ifstream is(in_file, std::ifstream::binary);
+    std::string expected((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+    mapped_file file(in_file);
+    BOOST_CHECK_EQUAL(expected.size(), file.size());
+    BOOST_CHECK(std::string(file.data(), file.size()) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_reader_over_mapped_file)
+{
+    std::string in_file = "./input/address-book.json";
+    std::ifstream is(in_file);
+    json expected = json::parse(is);
+
+    mapped_file file(in_file);
+    json_decoder<json> decoder;
+    json_reader reader(file.view(), decoder);
+    reader.read();
+    BOOST_CHECK(decoder.is_valid());
+    BOOST_CHECK_EQUAL(expected, decoder.get_result());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_reader_over_string_read_buffer)
+{
+    // A reader of a string has no stream to read blocks from
+    std::string s = "[1,2]";
+    json_decoder<json> decoder;
+    json_reader reader(s, decoder);
+    reader.buffer_length(1 << 20);
+    reader.read();
+    BOOST_CHECK_EQUAL(json::parse(s), decoder.get_result());
+
+    std::error_code ec;
+    reader.read_buffer(ec);
+    BOOST_CHECK(!ec);
+    BOOST_CHECK(reader.eof());
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_file_with_bom)
+{
+    std::string out_file = "./output/mapped-file-bom.json";
+    {
+        std::ofstream os(out_file, std::ofstream::binary);
+        os << "\xEF\xBB\xBF" << R"({"a":[1,2,"three"]})";
+    }
+
+    json j = json::parse_file(out_file);
+    BOOST_CHECK_EQUAL(json::parse(R"({"a":[1,2,"three"]})"), j);
+
+    mapped_file file(out_file);
+    json_decoder<json> decoder;
+    json_reader reader(file.view(), decoder);
+    reader.read();
+    BOOST_CHECK_EQUAL(j, decoder.get_result());
+}
+
+BOOST_AUTO_TEST_CASE(test_mapped_file_missing)
+{
+    std::error_code ec;
+    mapped_file file("./input/no-such-file.json", ec);
+    BOOST_CHECK(ec);
+    BOOST_CHECK_EQUAL(0, file.size());
+
+    BOOST_CHECK_THROW(mapped_file("./input/no-such-file.json"), std::system_error);
+    BOOST_CHECK_THROW(json::parse_file("./input/no-such-file.json"), parse_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
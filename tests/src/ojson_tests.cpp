@@ -107,5 +107,101 @@ BOOST_AUTO_TEST_CASE(test_object_emplace)
     o.erase("unit_type");
 }
 
+BOOST_AUTO_TEST_CASE(test_object_hash_index)
+{
+    // Keeps a list of the expected keys in order alongside the object
+    std::vector<std::string> keys;
+    ojson o;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        std::string key = "key" + std::to_string(i);
+        o.insert_or_assign(key, i);
+        keys.push_back(key);
+    }
+    BOOST_CHECK(o.object_value().has_hash_index());
+
+    // Inserts in the middle shift the positions of the members after them
+    auto hint = o.find("key50");
+    o.try_emplace(hint, "inserted", "value");
+    keys.insert(keys.begin() + 50, "inserted");
+
+    // Erase from the front, the middle and the end
+    for (const auto& key : {"key0", "key100", "key199", "key7", "key150"})
+    {
+        o.erase(key);
+        keys.erase(std::find(keys.begin(), keys.end(), key));
+    }
+    o["key3"] = "assigned";
+
+    BOOST_REQUIRE_EQUAL(keys.size(), o.size());
+    size_t i = 0;
+    for (const auto& member : o.object_range())
+    {
+        BOOST_CHECK_EQUAL(keys[i], std::string(member.key()));
+        BOOST_CHECK(o.find(keys[i]) != o.object_range().end());
+        BOOST_CHECK_EQUAL(keys[i], std::string(o.find(keys[i])->key()));
+        ++i;
+    }
+    BOOST_CHECK(!o.has_key("key0"));
+    BOOST_CHECK_EQUAL(0, o.count("key100"));
+    BOOST_CHECK_EQUAL(1, o.count("key101"));
+    BOOST_CHECK_EQUAL(std::string("assigned"), o["key3"].as<std::string>());
+    BOOST_CHECK_EQUAL(std::string("value"), o["inserted"].as<std::string>());
+
+    // Equality doesn't depend on order
+    ojson reversed;
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it)
+    {
+        reversed.insert_or_assign(*it, o[*it]);
+    }
+    BOOST_CHECK(reversed == o);
+    reversed["key101"] = 0;
+    BOOST_CHECK(reversed != o);
+
+    ojson copy = o;
+    BOOST_CHECK(copy.object_value().has_hash_index());
+    BOOST_CHECK_EQUAL(std::string("key101"), std::string(copy.find("key101")->key()));
+
+    // Dropped below the threshold
+    while (o.size() > 10)
+    {
+        o.erase(o.object_range().begin()->key());
+    }
+    BOOST_CHECK(!o.object_value().has_hash_index());
+    BOOST_CHECK(o.find(keys.back()) != o.object_range().end());
+}
+
+struct unindexed_policy : public preserve_order_policy
+{
+    static const size_t object_hash_index_threshold = 0;
+};
+
+BOOST_AUTO_TEST_CASE(test_object_hash_index_threshold)
+{
+    typedef basic_json<char,unindexed_policy> unindexed_json;
+
+    std::string s = "{";
+    for (size_t i = 0; i < 100; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(",");
+        }
+        s.append("\"k" + std::to_string(99 - i) + "\":" + std::to_string(i));
+    }
+    s.append("}");
+
+    ojson o = ojson::parse(s);
+    unindexed_json u = unindexed_json::parse(s);
+    BOOST_CHECK(o.object_value().has_hash_index());
+    BOOST_CHECK(!u.object_value().has_hash_index());
+    BOOST_CHECK_EQUAL(std::string("k99"), std::string(o.object_range().begin()->key()));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        std::string key = "k" + std::to_string(i);
+        BOOST_CHECK_EQUAL(o[key].as<int>(), u[key].as<int>());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,106 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/parallel_parse.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(parallel_parse_tests)
+
+static std::string make_records(size_t count)
+{
+    std::string s = "[\n";
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(",\n");
+        }
+        s.append("  {\"id\":" + std::to_string(i)
+                 + ",\"text\":\"},{\\\"x\\\":[1,2],\\\"y\\\":\\\"" + std::to_string(i) + "\\\"\""
+                 + ",\"items\":[{\"a\":1,\"b\":[true,null]},{\"a\":2.5,\"b\":[]}]}");
+    }
+    s.append("\n]\n");
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_records)
+{
+    std::string s = make_records(5000);
+    json expected = json::parse(s);
+
+    for (size_t num_threads : {2, 3, 4, 8})
+    {
+        json j = parallel_parse<json>(s, num_threads);
+        BOOST_REQUIRE(j.is_array());
+        BOOST_REQUIRE_EQUAL(5000, j.size());
+        BOOST_CHECK_EQUAL(expected, j);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_scalars)
+{
+    std::string s = "[";
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        if (i > 0)
+        {
+            s.append(i % 3 == 0 ? "," : ", ");
+        }
+        s.append(i % 2 == 0 ? std::to_string(i) : "\"s,\\\"" + std::to_string(i) + "\"");
+    }
+    s.append("]");
+    json expected = json::parse(s);
+
+    json j = parallel_parse<json>(s, 4);
+    BOOST_CHECK_EQUAL(expected, j);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_boundary_guess)
+{
+    std::string s = R"(a,b"]}, {"c":[1,2]}, "d")";
+    // Starts inside a string, the best comma is the one at the lowest depth
+    const char* p = detail::guess_element_boundary(s.data(), s.data(), s.data() + s.length());
+    BOOST_CHECK_EQUAL(6, p - s.data());
+
+    std::string t = R"(1,[2,3],4)";
+    p = detail::guess_element_boundary(t.data(), t.data() + 3, t.data() + t.length());
+    BOOST_CHECK_EQUAL(7, p - t.data());
+
+    // Starts on the opening quotation mark of a string that begins with a brace
+    std::string u = R"({"a":"},{","b":1},{"c":2})";
+    p = detail::guess_element_boundary(u.data(), u.data() + 5, u.data() + u.length());
+    BOOST_CHECK_EQUAL(17, p - u.data());
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_not_an_array)
+{
+    std::string s = make_records(2000);
+    std::string o = "{\"records\":" + s + "}";
+
+    json j = parallel_parse<json>(o, 4);
+    BOOST_CHECK_EQUAL(2000, j["records"].size());
+
+    json k = parallel_parse<json>(std::string("[1,2,3]"), 4);
+    BOOST_CHECK_EQUAL(3, k.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse_invalid)
+{
+    std::string s = make_records(3000);
+    size_t pos = s.find(",\n", s.length()/2);
+    s.insert(pos, ",");
+
+    BOOST_CHECK_THROW(parallel_parse<json>(s, 4), parse_error);
+
+    std::string t = make_records(3000);
+    t.insert(t.length() - 3, ",");
+    BOOST_CHECK_THROW(parallel_parse<json>(t, 4), parse_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -134,6 +134,62 @@ BOOST_AUTO_TEST_CASE(test_parse_big_string2)
     //}
 }
 
+class string_view_recorder : public basic_null_json_input_handler<char>
+{
+public:
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    std::vector<const char*> data;
+private:
+    void do_name(const string_view_type& name, const parsing_context&) override
+    {
+        names.push_back(std::string(name.data(),name.length()));
+        data.push_back(name.data());
+    }
+
+    void do_string_value(const string_view_type& value, const parsing_context&) override
+    {
+        values.push_back(std::string(value.data(),value.length()));
+        data.push_back(value.data());
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_parse_string_views_into_source)
+{
+    std::string s = R"({"a-member-name-longer-than-sixteen-bytes":"plain value","b":"caf\u00e9 \"q\" caf)" "\xC3\xA9" R"("})";
+
+    string_view_recorder recorder;
+    json_parser parser(recorder);
+    parser.set_source(s.data(),s.length());
+    parser.parse();
+    parser.end_parse();
+    BOOST_CHECK(parser.done());
+
+    BOOST_REQUIRE_EQUAL(2,recorder.names.size());
+    BOOST_CHECK_EQUAL(std::string("a-member-name-longer-than-sixteen-bytes"),recorder.names[0]);
+    BOOST_CHECK_EQUAL(std::string("b"),recorder.names[1]);
+    BOOST_REQUIRE_EQUAL(2,recorder.values.size());
+    BOOST_CHECK_EQUAL(std::string("plain value"),recorder.values[0]);
+    BOOST_CHECK_EQUAL(std::string("caf\xC3\xA9 \"q\" caf\xC3\xA9"),recorder.values[1]);
+
+    // Strings without escapes are passed as views into the source
+    BOOST_CHECK(recorder.data[0] == s.data() + 2);
+    BOOST_CHECK(recorder.data[1] == s.data() + 44);
+    BOOST_CHECK(recorder.data[2] == s.data() + 58);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_string_with_invalid_utf8_after_ascii_run)
+{
+    std::string s = "[\"0123456789abcdef0123456789abcdef\xFF\"]";
+
+    std::error_code ec;
+    string_view_recorder recorder;
+    json_parser parser(recorder);
+    parser.set_source(s.data(),s.length());
+    parser.parse(ec);
+    BOOST_CHECK(ec == json_parser_errc::illegal_codepoint);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,156 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/pmr_json.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#if defined(JSONCONS_HAS_PMR)
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(pmr_json_tests)
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    size_t allocate_count = 0;
+    size_t deallocate_count = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocate_count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        ++deallocate_count;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+static const std::string s = R"(
+{
+    "name" : "a name that is too long to be stored inline",
+    "values" : [1, 2.5, "another string that is too long to be stored inline", {"x" : [true, null]}],
+    "empty" : {}
+}
+)";
+
+BOOST_AUTO_TEST_CASE(test_pmr_json_decode)
+{
+    counting_resource resource;
+    {
+        json_decoder<pmr::json> decoder{pmr::polymorphic_allocator<char>(&resource)};
+        json_reader reader(s, decoder);
+        reader.read();
+        pmr::json j = decoder.get_result();
+
+        BOOST_CHECK(resource.allocate_count > 0);
+        BOOST_CHECK(j.object_value().get_allocator().resource() == &resource);
+        BOOST_CHECK_EQUAL(std::string("a name that is too long to be stored inline"), j["name"].as<std::string>());
+        BOOST_CHECK(j["values"][3]["x"][1].is_null());
+        BOOST_CHECK_EQUAL(pmr::json::parse(s), j);
+    }
+    BOOST_CHECK_EQUAL(resource.allocate_count, resource.deallocate_count);
+}
+
+BOOST_AUTO_TEST_CASE(test_pmr_json_resources)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::monotonic_buffer_resource monotonic(&pool);
+
+    for (std::pmr::memory_resource* resource : {static_cast<std::pmr::memory_resource*>(&pool),
+                                                static_cast<std::pmr::memory_resource*>(&monotonic)})
+    {
+        json_decoder<pmr::ojson> decoder{pmr::polymorphic_allocator<char>(resource)};
+        json_reader reader(s, decoder);
+        reader.read();
+        pmr::ojson j = decoder.get_result();
+
+        j["added"] = pmr::ojson("a string added after parsing, long enough for the heap",
+                                pmr::polymorphic_allocator<char>(resource));
+        pmr::ojson k = j;
+        BOOST_CHECK_EQUAL(j, k);
+        BOOST_CHECK_EQUAL(std::string("name"), std::string(j.object_range().begin()->key()));
+        BOOST_CHECK(j.object_value().get_allocator().resource() == resource);
+        BOOST_CHECK(k.object_value().get_allocator().resource() == resource);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_pmr_json_large_object)
+{
+    std::string text = "{";
+    for (int i = 0; i < 200; ++i)
+    {
+        text += (i == 0 ? "\"" : ",\"") + std::string("member") + std::to_string((i*37) % 200) + "\":" + std::to_string(i);
+    }
+    text += "}";
+
+    counting_resource resource;
+    counting_resource other;
+    {
+        json_decoder<pmr::json> decoder{pmr::polymorphic_allocator<char>(&resource)};
+        json_reader reader(text, decoder);
+        reader.read();
+        pmr::json j = decoder.get_result();
+        BOOST_CHECK(j.object_value().has_key_prefixes());
+
+        pmr::json k = j;
+        pmr::json l(std::move(k), pmr::polymorphic_allocator<char>(&other));
+        BOOST_CHECK_EQUAL(j, l);
+
+        for (int i = 0; i < 190; ++i)
+        {
+            j.erase("member" + std::to_string(i));
+        }
+        BOOST_CHECK(!j.object_value().has_key_prefixes());
+        BOOST_CHECK_EQUAL(1, j.count("member195"));
+        l.object_value().clear();
+
+        json_decoder<pmr::ojson> odecoder{pmr::polymorphic_allocator<char>(&resource)};
+        json_reader oreader(text, odecoder);
+        oreader.read();
+        pmr::ojson o = odecoder.get_result();
+        BOOST_CHECK(o.object_value().has_hash_index());
+
+        pmr::ojson p = o;
+        pmr::ojson q(std::move(p), pmr::polymorphic_allocator<char>(&other));
+        BOOST_CHECK_EQUAL(o, q);
+
+        for (int i = 0; i < 190; ++i)
+        {
+            o.erase("member" + std::to_string(i));
+        }
+        BOOST_CHECK(!o.object_value().has_hash_index());
+        BOOST_CHECK_EQUAL(1, o.count("member195"));
+        q.object_value().clear();
+    }
+    BOOST_CHECK_EQUAL(resource.allocate_count, resource.deallocate_count);
+    BOOST_CHECK_EQUAL(other.allocate_count, other.deallocate_count);
+}
+
+BOOST_AUTO_TEST_CASE(test_pmr_string_interop)
+{
+    pmr::json j = pmr::json::parse(s);
+    std::pmr::string name = j["name"].as<std::pmr::string>();
+    BOOST_CHECK(name == "a name that is too long to be stored inline");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
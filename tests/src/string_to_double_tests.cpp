@@ -9,6 +9,8 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cstring>
+#include <cstdio>
 #include <jsoncons/detail/number_parsers.hpp>
 
 using namespace jsoncons;
@@ -56,5 +58,54 @@ BOOST_AUTO_TEST_CASE(test_exponent)
     //std::cout << std::numeric_limits<double>::max() << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_string_to_double_corpus)
+{
+    // Boundary, halfway and long mantissa cases, compared with strtod
+    const char* corpus[] = 
+    {
+        "0.1", "0.2", "0.3", "1e23", "1e-22", "1e22", "8.98846567431158e307",
+        "2.2250738585072011e-308", "2.2250738585072012e-308", "2.2250738585072014e-308",
+        "1.7976931348623157e308", "4.9e-324", "2.4703282292062327e-324",
+        "9007199254740991", "9007199254740992", "9007199254740993", "7.2057594037927933e16",
+        "4503599627370496.5", "4503599627370497.5", "123456789012345678", "12345678901234567890",
+        "0.0000000000000000000123456789012345678", "1.00000000000000011102230246251565404236316680908203125",
+        "-65.613616999999977", "-0.0", "1E5", "1e+5", "1e-5", "5e-324", "1.7976931348623159e308"
+    };
+
+    detail::string_to_double reader;
+    for (const char* s : corpus)
+    {
+        double expected = strtod(s, nullptr);
+        double actual = reader(s, strlen(s));
+        BOOST_CHECK_MESSAGE(std::memcmp(&expected, &actual, sizeof(double)) == 0, s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_string_to_double_round_trip)
+{
+    detail::string_to_double reader;
+
+    uint64_t bits = 0x9e3779b97f4a7c15ULL;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double expected;
+        std::memcpy(&expected, &bits, sizeof(double));
+        if (!(expected == expected) || expected - expected != 0)
+        {
+            continue;
+        }
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%.17g", expected);
+        double actual = reader(buffer, length);
+        BOOST_REQUIRE_MESSAGE(std::memcmp(&expected, &actual, sizeof(double)) == 0, buffer);
+
+        json j = json::parse(buffer);
+        BOOST_REQUIRE_EQUAL(expected, j.as<double>());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 